@@ -0,0 +1,165 @@
+#include <QBuffer>
+#include <QCoreApplication>
+#include <QDirIterator>
+#include <QTemporaryDir>
+#include <CLI/CLI.hpp>
+#include <iostream>
+#include "benchmark.h"
+#include "corpus.h"
+#include "exception.h"
+#include "io/documentreader.h"
+#include "io/pboheaderreader.h"
+#include "io/lzh/lzh.h"
+#include "model/task/packtask.h"
+#include "model/task/unpacktask.h"
+
+using namespace std;
+
+namespace pboman3::bench {
+    using namespace io;
+    using namespace model::task;
+
+    void QuietLogger(QtMsgType type, const QMessageLogContext& context, const QString& msg) {
+        //the tasks log every step, which would both clutter the output and skew the numbers
+        if (type == QtDebugMsg || type == QtInfoMsg)
+            return;
+        cerr << (context.file ? context.file : "") << "|" << msg.toStdString() << endl;
+    }
+
+    qint64 FolderSize(const QString& path) {
+        qint64 size = 0;
+        QDirIterator it(path, QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            it.next();
+            size += it.fileInfo().size();
+        }
+        return size;
+    }
+
+    void AddLzhBenchmarks(BenchmarkRunner& runner, Corpus& corpus, const QDir& root) {
+        const QString textFile = root.filePath("text.sqf");
+        const QString compressedFile = root.filePath("text.lzh");
+        const QString outputFile = root.filePath("text.out");
+        constexpr qsizetype textSize = 8 * 1024 * 1024;
+        Corpus::writeFile(textFile, corpus.text(textSize));
+
+        const Cancel cancel = []() { return false; };
+
+        runner.add("lzh_compress", "bytes", [=]() {
+            QFile source(textFile);
+            source.open(QIODeviceBase::ReadOnly);
+            QFile target(outputFile);
+            target.open(QIODeviceBase::WriteOnly | QIODeviceBase::Truncate);
+            Lzh::compress(&source, &target, cancel);
+            return source.size();
+        });
+
+        QFile source(textFile);
+        source.open(QIODeviceBase::ReadOnly);
+        QFile compressed(compressedFile);
+        compressed.open(QIODeviceBase::WriteOnly | QIODeviceBase::Truncate);
+        Lzh::compress(&source, &compressed, cancel);
+        compressed.close();
+
+        runner.add("lzh_decompress", "bytes", [=]() {
+            QFile lzh(compressedFile);
+            lzh.open(QIODeviceBase::ReadOnly);
+            QBuffer target;
+            target.open(QIODeviceBase::WriteOnly);
+            Lzh::decompress(&lzh, &target, static_cast<int>(textSize), cancel);
+            return static_cast<qint64>(textSize);
+        });
+    }
+
+    void AddPboBenchmarks(BenchmarkRunner& runner, Corpus& corpus, const QDir& root, qint32 tinyFiles) {
+        const QString corpusDir = root.filePath("corpus");
+        const QString packedDir = root.filePath("packed");
+        const QString unpackedDir = root.filePath("unpacked");
+        const QString pboFile = QDir(packedDir).filePath("corpus.pbo");
+        corpus.writeFolder(corpusDir, tinyFiles);
+        root.mkpath("packed");
+
+        const Cancel cancel = []() { return false; };
+        PackTask(corpusDir, packedDir).execute(cancel);
+
+        PboFile pbo(pboFile);
+        pbo.open(QIODeviceBase::ReadOnly);
+        const qint64 entriesCount = PboHeaderReader::readFileHeader(&pbo).entries.count();
+        const qint64 pboSize = pbo.size();
+        pbo.close();
+
+        runner.add("pbo_read_header", "entries", [=]() {
+            PboFile file(pboFile);
+            file.open(QIODeviceBase::ReadOnly);
+            return static_cast<qint64>(PboHeaderReader::readFileHeader(&file).entries.count());
+        });
+
+        runner.add("pbo_read_document", "entries", [=]() {
+            const QSharedPointer<PboDocument> document = DocumentReader(pboFile).read();
+            return entriesCount;
+        });
+
+        const qint64 corpusSize = FolderSize(corpusDir);
+        runner.add("pack_task", "bytes", [=]() {
+            PackTask(corpusDir, packedDir).execute(cancel);
+            return corpusSize;
+        }, [=]() {
+            QFile::remove(pboFile);
+        });
+
+        runner.add("unpack_task", "bytes", [=]() {
+            UnpackTask(pboFile, unpackedDir).execute(cancel);
+            return pboSize;
+        }, [=]() {
+            QDir(unpackedDir).removeRecursively();
+            QDir(root).mkpath("unpacked");
+        });
+    }
+
+    int RunBenchmarks(int argc, char* argv[]) {
+        CLI::App cli("Measures the throughput of the PBO Manager internals");
+        string output;
+        string filter;
+        int iterations = 5;
+        int tinyFiles = 5000;
+        cli.add_option("-o,--output", output, "The JSON file to write the results to");
+        cli.add_option("-f,--filter", filter, "Run only the benchmarks containing this text");
+        cli.add_option("-i,--iterations", iterations, "How many times to run each benchmark")->check(CLI::PositiveNumber);
+        cli.add_option("--tiny-files", tinyFiles, "How many tiny files to put into the corpus")->check(CLI::PositiveNumber);
+        CLI11_PARSE(cli, argc, argv)
+
+        QCoreApplication app(argc, argv);
+        qInstallMessageHandler(QuietLogger);
+
+        const QTemporaryDir workDir;
+        const QDir root(workDir.path());
+        Corpus corpus;
+
+        BenchmarkRunner runner(iterations, QString::fromStdString(filter));
+        AddLzhBenchmarks(runner, corpus, root);
+        AddPboBenchmarks(runner, corpus, root, tinyFiles);
+
+        const QList<BenchmarkResult> results = runner.run(cerr);
+        const QByteArray json = BenchmarkRunner::toJson(results).toJson();
+        if (output.empty()) {
+            cout << json.constData();
+        } else {
+            QFile file(QString::fromStdString(output));
+            if (!file.open(QIODeviceBase::WriteOnly | QIODeviceBase::Truncate)) {
+                cerr << "Could not write the results to " << output << endl;
+                return 1;
+            }
+            file.write(json);
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        return pboman3::bench::RunBenchmarks(argc, argv);
+    } catch (const pboman3::AppException& ex) {
+        cerr << "The benchmark failed: " << ex.message().toStdString() << endl;
+        return 1;
+    }
+}
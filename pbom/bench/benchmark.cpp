@@ -0,0 +1,78 @@
+#include "benchmark.h"
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <algorithm>
+#include <iomanip>
+
+namespace pboman3::bench {
+    BenchmarkRunner::BenchmarkRunner(qint32 iterations, QString filter)
+        : iterations_(iterations),
+          filter_(std::move(filter)) {
+    }
+
+    void BenchmarkRunner::add(const QString& name, const QString& unit, const Run& run, const SetUp& setUp) {
+        benchmarks_.append(Benchmark{name, unit, run, setUp});
+    }
+
+    QList<BenchmarkResult> BenchmarkRunner::run(std::ostream& log) const {
+        QList<BenchmarkResult> results;
+        for (const Benchmark& benchmark : benchmarks_) {
+            if (!filter_.isEmpty() && !benchmark.name.contains(filter_, Qt::CaseInsensitive))
+                continue;
+
+            const BenchmarkResult result = measure(benchmark);
+            results.append(result);
+
+            const bool bytes = result.unit == "bytes";
+            log << std::left << std::setw(32) << result.name.toStdString()
+                << std::right << std::setw(12) << std::fixed << std::setprecision(2) << result.medianMs << " ms"
+                << std::setw(14) << (bytes ? result.perSecond / 1024 / 1024 : result.perSecond)
+                << (bytes ? " MB/s" : " " + result.unit.toStdString() + "/s") << std::endl;
+        }
+        return results;
+    }
+
+    BenchmarkResult BenchmarkRunner::measure(const Benchmark& benchmark) const {
+        //the first run warms up the disk cache and the allocator, it is not counted
+        if (benchmark.setUp)
+            benchmark.setUp();
+        qint64 processed = benchmark.run();
+
+        QList<double> times;
+        times.reserve(iterations_);
+        for (qint32 i = 0; i < iterations_; i++) {
+            if (benchmark.setUp)
+                benchmark.setUp();
+            QElapsedTimer timer;
+            timer.start();
+            processed = benchmark.run();
+            times.append(static_cast<double>(timer.nsecsElapsed()) / 1000000);
+        }
+
+        std::sort(times.begin(), times.end());
+        const double median = times.at(times.count() / 2);
+        const double perSecond = median > 0 ? static_cast<double>(processed) * 1000 / median : 0;
+        return BenchmarkResult{benchmark.name, benchmark.unit, iterations_, processed, times.first(), median, perSecond};
+    }
+
+    QJsonDocument BenchmarkRunner::toJson(const QList<BenchmarkResult>& results) {
+        QJsonArray benchmarks;
+        for (const BenchmarkResult& result : results) {
+            QJsonObject item;
+            item.insert("name", result.name);
+            item.insert("unit", result.unit);
+            item.insert("iterations", result.iterations);
+            item.insert("processed", result.processed);
+            item.insert("min_ms", result.minMs);
+            item.insert("median_ms", result.medianMs);
+            item.insert("per_second", result.perSecond);
+            benchmarks.append(item);
+        }
+
+        QJsonObject root;
+        root.insert("version", PBOM_VERSION);
+        root.insert("benchmarks", benchmarks);
+        return QJsonDocument(root);
+    }
+}
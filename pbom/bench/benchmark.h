@@ -0,0 +1,50 @@
+#pragma once
+
+#include <QJsonDocument>
+#include <QList>
+#include <QString>
+#include <functional>
+#include <ostream>
+
+namespace pboman3::bench {
+    struct BenchmarkResult {
+        QString name;
+        QString unit;
+        qint32 iterations;
+        qint64 processed;
+        double minMs;
+        double medianMs;
+        double perSecond;
+    };
+
+    class BenchmarkRunner {
+    public:
+        //prepares the state for an iteration, not counted in the time
+        typedef std::function<void()> SetUp;
+
+        //runs an iteration and returns the amount of units it processed
+        typedef std::function<qint64()> Run;
+
+        BenchmarkRunner(qint32 iterations, QString filter);
+
+        void add(const QString& name, const QString& unit, const Run& run, const SetUp& setUp = nullptr);
+
+        QList<BenchmarkResult> run(std::ostream& log) const;
+
+        static QJsonDocument toJson(const QList<BenchmarkResult>& results);
+
+    private:
+        struct Benchmark {
+            QString name;
+            QString unit;
+            Run run;
+            SetUp setUp;
+        };
+
+        qint32 iterations_;
+        QString filter_;
+        QList<Benchmark> benchmarks_;
+
+        BenchmarkResult measure(const Benchmark& benchmark) const;
+    };
+}
@@ -0,0 +1,65 @@
+#include "corpus.h"
+#include <QFile>
+#include "io/diskaccessexception.h"
+
+namespace pboman3::bench {
+    using namespace io;
+
+    Corpus::Corpus(quint32 seed)
+        : random_(seed) {
+    }
+
+    QByteArray Corpus::text(qsizetype size) {
+        static const char* words[] = {
+            "private", "_unit", "=", "_this", "select", "0;", "if", "(alive", "player)", "then", "{",
+            "};", "params", "[\"_vehicle\",", "objNull];", "forEach", "allUnits;", "hint", "\"done\";",
+            "_i", "+", "1;", "setDamage", "getPos", "call", "compile", "preprocessFileLineNumbers"
+        };
+        constexpr int wordsCount = sizeof words / sizeof words[0];
+
+        QByteArray result;
+        result.reserve(size + 32);
+        while (result.size() < size) {
+            result.append(words[random_.bounded(wordsCount)]);
+            result.append(random_.bounded(8) == 0 ? '\n' : ' ');
+        }
+        result.truncate(size);
+        return result;
+    }
+
+    QByteArray Corpus::binary(qsizetype size) {
+        QByteArray result(size, Qt::Uninitialized);
+        for (qsizetype i = 0; i < size; i++) {
+            result[i] = static_cast<char>(random_.bounded(256));
+        }
+        return result;
+    }
+
+    void Corpus::writeFolder(const QDir& dir, qint32 tinyFiles) {
+        dir.mkpath("scripts");
+        dir.mkpath("assets");
+        dir.mkpath("tiny");
+
+        writeFile(dir.filePath("pbo.json"), "{\"compress\":{\"include\":[\"\\\\.sqf$\"]}}");
+
+        for (int i = 0; i < 16; i++) {
+            writeFile(dir.filePath(QString("scripts/script%1.sqf").arg(i)), text(256 * 1024));
+        }
+
+        for (int i = 0; i < 8; i++) {
+            writeFile(dir.filePath(QString("assets/asset%1.paa").arg(i)), binary(1024 * 1024));
+        }
+
+        for (int i = 0; i < tinyFiles; i++) {
+            const qsizetype size = 64 + random_.bounded(448);
+            writeFile(dir.filePath(QString("tiny/file%1.hpp").arg(i)), text(size));
+        }
+    }
+
+    void Corpus::writeFile(const QString& path, const QByteArray& data) {
+        QFile file(path);
+        if (!file.open(QIODeviceBase::WriteOnly))
+            throw DiskAccessException("Could not write the benchmark file", path);
+        file.write(data);
+    }
+}
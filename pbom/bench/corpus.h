@@ -0,0 +1,26 @@
+#pragma once
+
+#include <QDir>
+#include <QRandomGenerator>
+
+namespace pboman3::bench {
+    //generates the same synthetic files on every run, so that the numbers of different runs are comparable
+    class Corpus {
+    public:
+        explicit Corpus(quint32 seed = 20211017);
+
+        //script-like text which compresses well
+        QByteArray text(qsizetype size);
+
+        //asset-like binary data which barely compresses
+        QByteArray binary(qsizetype size);
+
+        //a folder of scripts, assets and many tiny files, with a pbo.json compressing the scripts
+        void writeFolder(const QDir& dir, qint32 tinyFiles);
+
+        static void writeFile(const QString& path, const QByteArray& data);
+
+    private:
+        QRandomGenerator random_;
+    };
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <CLI/CLI.hpp>
 
 namespace pboman3 {
@@ -35,7 +36,13 @@ namespace pboman3 {
 
         struct PackCommandBase : Command {
             PackCommandBase()
-                : optOutputPath(nullptr)
+                : jobs(1),
+                  statsFormat("table"),
+                  optOutputPath(nullptr),
+                  optJobs(nullptr),
+                  optStats(nullptr),
+                  optStatsFormat(nullptr),
+                  optTrace(nullptr)
 #ifdef PBOM_GUI
                   , optPrompt(nullptr)
                   , optNoUi(nullptr)
@@ -44,7 +51,14 @@ namespace pboman3 {
             }
 
             string outputPath;
+            int jobs;
+            string statsFormat;
+            string tracePath;
             Option* optOutputPath;
+            Option* optJobs;
+            Option* optStats;
+            Option* optStatsFormat;
+            Option* optTrace;
 #ifdef PBOM_GUI
             Option* optPrompt;
             Option* optNoUi;
@@ -53,6 +67,44 @@ namespace pboman3 {
             bool hasOutputPath() const {
                 return !!*optOutputPath;
             }
+
+            bool stats() const {
+                return !!*optStats;
+            }
+
+            bool hasTracePath() const {
+                return !!*optTrace;
+            }
+
+            void configureJobs() {
+                optJobs = command->add_option("-j,--jobs", jobs,
+                                              "The number of PBOs to process in parallel, 0 means one per CPU core; "
+                                              "this is not a thread limit, the work on a single PBO is spread across the cores as well")
+                                 ->check(NonNegativeNumber);
+#ifdef PBOM_GUI
+                optJobs->needs(optNoUi);
+#endif
+            }
+
+            void configureStats() {
+                optStats = command->add_flag("--stats",
+                                             "Print the time and the bytes each phase of each task took");
+                optStatsFormat = command->add_option("--stats-format", statsFormat,
+                                                     "How to print the stats: table or json")
+                                        ->check(IsMember({"table", "json"}))
+                                        ->needs(optStats);
+#ifdef PBOM_GUI
+                optStats->needs(optNoUi);
+#endif
+            }
+
+            void configureTrace() {
+                optTrace = command->add_option("--trace", tracePath,
+                                               "Write the timeline of the run to the file in the Chrome trace format");
+#ifdef PBOM_GUI
+                optTrace->needs(optNoUi);
+#endif
+            }
 #ifdef PBOM_GUI
             bool prompt() const {
                 return !!*optPrompt;
@@ -74,9 +126,15 @@ namespace pboman3 {
                        ->required()
                        ->check(ExistingDirectory);
 
+#ifdef PBOM_GUI
                 optOutputPath = command->add_option("-o,--output-directory", outputPath,
                                                     "The directory to write the resulting PBO(s)")
                                        ->check(ExistingDirectory);
+#else
+                optOutputPath = command->add_option("-o,--output-directory", outputPath,
+                                                    "The directory to write the resulting PBO(s), \"-\" writes a single PBO to stdout")
+                                       ->check(ExistingDirectory | IsMember({"-"}));
+#endif
 
 #ifdef PBOM_GUI
                 optPrompt = command->add_flag("-p,--prompt",
@@ -86,18 +144,48 @@ namespace pboman3 {
                 optNoUi = command->add_flag("-u,--no-ui", "Run the application without the GUI")
                                  ->excludes(optPrompt);
 #endif
+
+                configureJobs();
+                configureStats();
+                configureTrace();
             }
         };
 
         struct CommandUnpack : PackCommandBase {
+            CommandUnpack()
+                : optInclude(nullptr),
+                  optExclude(nullptr),
+                  optFilesFrom(nullptr) {
+            }
+
             vector<string> files;
+            vector<string> includes;
+            vector<string> excludes;
+            string filesFrom;
+            Option* optInclude;
+            Option* optExclude;
+            Option* optFilesFrom;
+
+            bool hasFilesFrom() const {
+                return !!*optFilesFrom;
+            }
 
             void configure(App* cli) override {
                 command = cli->add_subcommand("unpack", "Unpack the specified PBO(s)");
 
+#ifdef PBOM_GUI
                 command->add_option("files", files, "The PBO(s) to unpack")
                        ->required()
                        ->check(ExistingFile);
+#else
+                command->add_option("files", files, "The PBO(s) to unpack, \"-\" reads a PBO from stdin")
+                       ->required()
+                       ->check(ExistingFile | IsMember({"-"}));
+                command->callback([this]() {
+                    if (std::count(files.begin(), files.end(), "-") > 1)
+                        throw ValidationError("files", "stdin (\"-\") can be given only once");
+                });
+#endif
 
                 optOutputPath = command->add_option("-o,--output-directory", outputPath,
                                                     "The directory to write the PBO(s) contents")
@@ -109,9 +197,171 @@ namespace pboman3 {
                 optNoUi = command->add_flag("-u,--no-ui", "Run the application without the GUI")
                                  ->excludes(optPrompt);
 #endif
+
+                optInclude = command->add_option("--include", includes,
+                                                 "Extract only the entries matching the glob, * - within a folder, ** - across folders")
+                                    ->expected(1)
+                                    ->take_all();
+                optExclude = command->add_option("--exclude", excludes,
+                                                 "Do not extract the entries matching the glob")
+                                    ->expected(1)
+                                    ->take_all();
+                optFilesFrom = command->add_option("--files-from", filesFrom,
+                                                   "Extract only the entries listed in the file, one path per line")
+                                      ->check(ExistingFile);
+#ifdef PBOM_GUI
+                optInclude->needs(optNoUi);
+                optExclude->needs(optNoUi);
+                optFilesFrom->needs(optNoUi);
+#endif
+
+                configureJobs();
+                configureStats();
+                configureTrace();
+            }
+        };
+
+#ifndef PBOM_GUI
+        struct CommandList : Command {
+            CommandList()
+                : jobs(1),
+                  optJson(nullptr) {
+            }
+
+            vector<string> files;
+            int jobs;
+            Option* optJson;
+
+            bool json() const {
+                return !!*optJson;
+            }
+
+            void configure(App* cli) override {
+                command = cli->add_subcommand("list", "List the entries of the specified PBO(s) reading just the headers");
+
+                command->add_option("files", files, "The PBO(s) to list")
+                       ->required()
+                       ->check(ExistingFile);
+
+                optJson = command->add_flag("--json", "Print a JSON object per PBO instead of a line per entry");
+
+                command->add_option("-j,--jobs", jobs,
+                                    "The number of PBOs to read in parallel, 0 means one per CPU core")
+                       ->check(NonNegativeNumber);
+            }
+        };
+
+        struct CommandCat : Command {
+            string file;
+            string entry;
+
+            void configure(App* cli) override {
+                command = cli->add_subcommand("cat", "Write the contents of a single PBO entry to stdout");
+
+                command->add_option("file", file, "The PBO to read")
+                       ->required()
+                       ->check(ExistingFile);
+
+                command->add_option("entry", entry, "The path of the entry inside the PBO, e.g. scripts\\init.sqf")
+                       ->required();
+            }
+        };
+
+        struct CommandVerify : Command {
+            CommandVerify()
+                : jobs(0) {
+            }
+
+            vector<string> files;
+            int jobs;
+
+            void configure(App* cli) override {
+                command = cli->add_subcommand("verify", "Check the PBO(s) for corruption without unpacking them");
+
+                command->add_option("files", files, "The PBO(s) to verify")
+                       ->required()
+                       ->check(ExistingFile);
+
+                command->add_option("-j,--jobs", jobs,
+                                    "The number of PBOs to verify in parallel, 0 means one per CPU core")
+                       ->check(NonNegativeNumber);
+            }
+        };
+
+        struct CommandDiff : Command {
+            string fileA;
+            string fileB;
+
+            void configure(App* cli) override {
+                command = cli->add_subcommand("diff", "Compare the entries and the headers of two PBOs without unpacking them");
+
+                command->add_option("a", fileA, "The PBO to compare")
+                       ->required()
+                       ->check(ExistingFile);
+
+                command->add_option("b", fileB, "The PBO to compare with")
+                       ->required()
+                       ->check(ExistingFile);
             }
         };
 
+        struct CommandRecompress : Command {
+            CommandRecompress()
+                : optOutput(nullptr) {
+            }
+
+            string file;
+            string rulesFile;
+            string output;
+            Option* optOutput;
+
+            bool hasOutput() const {
+                return !!*optOutput;
+            }
+
+            void configure(App* cli) override {
+                command = cli->add_subcommand("recompress", "Compress the entries of a PBO by the rules of a pbo.json");
+
+                command->add_option("file", file, "The PBO to recompress")
+                       ->required()
+                       ->check(ExistingFile);
+
+                command->add_option("--rules", rulesFile, "The pbo.json with the compression rules")
+                       ->required()
+                       ->check(ExistingFile);
+
+                optOutput = command->add_option("-o,--output", output,
+                                                "The PBO to write, by default the file is replaced keeping the original as .bak");
+            }
+        };
+
+        struct CommandMerge : Command {
+            CommandMerge()
+                : onConflict("skip") {
+            }
+
+            vector<string> files;
+            string output;
+            string onConflict;
+
+            void configure(App* cli) override {
+                command = cli->add_subcommand("merge", "Combine several PBOs into one copying the entries as they are stored");
+
+                command->add_option("files", files, "The PBOs to merge, the earlier ones take precedence on skip")
+                       ->required()
+                       ->expected(2, -1)
+                       ->check(ExistingFile);
+
+                command->add_option("-o,--output", output, "The PBO to write")
+                       ->required();
+
+                command->add_option("--on-conflict", onConflict,
+                                    "What to do with an entry already merged from another PBO: skip, copy or replace")
+                       ->check(IsMember({"skip", "copy", "replace"}));
+            }
+        };
+#endif
+
         struct Result {
 #ifdef PBOM_GUI
             CommandOpen open;
@@ -120,6 +370,15 @@ namespace pboman3 {
             CommandPack pack;
 
             CommandUnpack unpack;
+
+#ifndef PBOM_GUI
+            CommandList list;
+            CommandCat cat;
+            CommandVerify verify;
+            CommandDiff diff;
+            CommandRecompress recompress;
+            CommandMerge merge;
+#endif
         };
 
         CommandLine(App* app)
@@ -133,6 +392,14 @@ namespace pboman3 {
 #endif
             result->pack.configure(app_);
             result->unpack.configure(app_);
+#ifndef PBOM_GUI
+            result->list.configure(app_);
+            result->cat.configure(app_);
+            result->verify.configure(app_);
+            result->diff.configure(app_);
+            result->recompress.configure(app_);
+            result->merge.configure(app_);
+#endif
 
             return result;
         }
@@ -1,36 +1,178 @@
+#include <QFile>
 #include <QScopedPointer>
 #include <QTimer>
 #include <CLI/CLI.hpp>
 #include "commandline.h"
+#include "model/pbodiff.h"
+#include "model/pboentryprinter.h"
+#include "model/pbolisting.h"
+#include "model/pbomerger.h"
 #include "model/pbomodel.h"
+#include "model/pborecompressor.h"
+#include "model/pboverifier.h"
 #include "exception.h"
+#include "model/task/batchtaskrunner.h"
 #include "model/task/packtask.h"
+#include "model/task/streamunpacktask.h"
 #include "model/task/unpacktask.h"
 #include "util/log.h"
+#include "util/tracer.h"
+
+#ifdef Q_OS_WIN
+#include <fcntl.h>
+#include <io.h>
+#endif
 
 #define LOG(...) LOGGER("Main", __VA_ARGS__)
 
 using namespace std;
 
 namespace pboman3 {
-    int RunConsolePackOperation(const QStringList& folders, const QString& outputDir) {
+    model::task::BatchTaskRunner::StatsFormat GetStatsFormat(const CommandLine::PackCommandBase& command) {
+        using StatsFormat = model::task::BatchTaskRunner::StatsFormat;
+        if (!command.stats())
+            return StatsFormat::None;
+        return command.statsFormat == "json" ? StatsFormat::Json : StatsFormat::Table;
+    }
+
+    bool GetEntryFilter(const CommandLine::CommandUnpack& command, io::PboEntryFilter& filter) {
+        for (const string& glob : command.includes)
+            filter.addInclude(CommandLine::toQt(glob));
+        for (const string& glob : command.excludes)
+            filter.addExclude(CommandLine::toQt(glob));
+        if (command.hasFilesFrom() && !filter.addPathsFrom(CommandLine::toQt(command.filesFrom))) {
+            cerr << "Could not read any entry paths from the file: " << command.filesFrom << endl;
+            return false;
+        }
+        return true;
+    }
+
+    domain::ConflictResolution GetConflictResolution(const CommandLine::CommandMerge& command) {
+        if (command.onConflict == "copy")
+            return domain::ConflictResolution::Copy;
+        if (command.onConflict == "replace")
+            return domain::ConflictResolution::Replace;
+        return domain::ConflictResolution::Skip;
+    }
+
+    QString GetTracePath(const CommandLine::Result& commandLine) {
+        if (commandLine.pack.hasBeenSet() && commandLine.pack.hasTracePath())
+            return CommandLine::toQt(commandLine.pack.tracePath);
+        if (commandLine.unpack.hasBeenSet() && commandLine.unpack.hasTracePath())
+            return CommandLine::toQt(commandLine.unpack.tracePath);
+        return "";
+    }
+
+    int RunConsolePackToStdoutOperation(const QString& folder, model::task::BatchTaskRunner::StatsFormat statsFormat) {
         util::UseLoggingMessagePattern();
+#ifdef Q_OS_WIN
+        _setmode(_fileno(stdout), _O_BINARY);
+#endif
+        cout.flush();
+        QFile output;
+        if (!output.open(stdout, QIODeviceBase::WriteOnly)) {
+            cerr << "Could not open stdout for writing" << endl;
+            return 1;
+        }
+        model::task::BatchTaskRunner runner(1);
+        runner.setStatsFormat(statsFormat);
+        runner.addTask(QSharedPointer<model::task::Task>(new model::task::PackTask(folder, &output)), folder);
+        //stdout carries the PBO, so the messages go to stderr
+        const int exitCode = runner.run(cerr);
+        output.flush();
+        return exitCode;
+    }
+
+    int RunConsolePackOperation(const QStringList& folders, const QString& outputDir, int jobs,
+                                model::task::BatchTaskRunner::StatsFormat statsFormat) {
+        if (outputDir == "-") {
+            if (folders.count() != 1) {
+                cerr << "Only a single folder can be packed to stdout" << endl;
+                return 1;
+            }
+            return RunConsolePackToStdoutOperation(folders.first(), statsFormat);
+        }
+
+        util::UseLoggingMessagePattern();
+        model::task::BatchTaskRunner runner(jobs);
+        runner.setStatsFormat(statsFormat);
         for (const QString& folder : folders) {
-            //don't parallelize to avoid mess in the console
-            model::task::PackTask task(folder, outputDir);
-            task.execute([] { return false; });
+            runner.addTask(QSharedPointer<model::task::Task>(new model::task::PackTask(folder, outputDir)), folder);
         }
-        return 0;
+        const int exitCode = runner.run(cout);
+        return exitCode;
     }
 
-    int RunConsoleUnpackOperation(const QStringList& folders, const QString& outputDir) {
+    int RunConsoleUnpackOperation(const QStringList& folders, const QString& outputDir, int jobs,
+                                  model::task::BatchTaskRunner::StatsFormat statsFormat,
+                                  const io::PboEntryFilter& filter) {
         util::UseLoggingMessagePattern();
+        model::task::BatchTaskRunner runner(jobs);
+        runner.setStatsFormat(statsFormat);
+        QFile stdIn;
         for (const QString& folder : folders) {
-            //don't parallelize to avoid mess in the console
-            model::task::UnpackTask task(folder, outputDir);
-            task.execute([] { return false; });
+            if (folder == "-") {
+#ifdef Q_OS_WIN
+                _setmode(_fileno(stdin), _O_BINARY);
+#endif
+                stdIn.open(stdin, QIODeviceBase::ReadOnly | QIODeviceBase::Unbuffered);
+                runner.addTask(QSharedPointer<model::task::Task>(
+                                   new model::task::StreamUnpackTask(&stdIn, "stdin", outputDir, filter)), "stdin");
+            } else {
+                runner.addTask(QSharedPointer<model::task::Task>(new model::task::UnpackTask(folder, outputDir, filter)), folder);
+            }
+        }
+        const int exitCode = runner.run(cout);
+        return exitCode;
+    }
+
+    int RunConsoleListOperation(const QStringList& files, bool json, int jobs) {
+        util::UseLoggingMessagePattern();
+        const model::PboListing listing(json ? model::PboListing::Format::Json : model::PboListing::Format::Text, jobs);
+        const int exitCode = listing.run(files, cout, cerr);
+        return exitCode;
+    }
+
+    int RunConsoleCatOperation(const QString& file, const QString& entryPath) {
+        util::UseLoggingMessagePattern();
+#ifdef Q_OS_WIN
+        //the entry is binary, no CRLF translation
+        _setmode(_fileno(stdout), _O_BINARY);
+#endif
+        cout.flush();
+        QFile output;
+        if (!output.open(stdout, QIODeviceBase::WriteOnly | QIODeviceBase::Unbuffered)) {
+            cerr << "Could not open stdout for writing" << endl;
+            return 1;
         }
-        return 0;
+        const int exitCode = model::PboEntryPrinter::run(file, entryPath, &output, cerr);
+        return exitCode;
+    }
+
+    int RunConsoleVerifyOperation(const QStringList& files, int jobs) {
+        util::UseLoggingMessagePattern();
+        const model::PboVerifier verifier(jobs);
+        const int exitCode = verifier.run(files, cout);
+        return exitCode;
+    }
+
+    int RunConsoleDiffOperation(const QString& fileA, const QString& fileB) {
+        util::UseLoggingMessagePattern();
+        const int exitCode = model::PboDiff::run(fileA, fileB, cout, cerr);
+        return exitCode;
+    }
+
+    int RunConsoleRecompressOperation(const QString& file, const QString& rulesFile, const QString& output) {
+        util::UseLoggingMessagePattern();
+        const int exitCode = model::PboRecompressor::run(file, rulesFile, output, cout, cerr);
+        return exitCode;
+    }
+
+    int RunConsoleMergeOperation(const QStringList& files, const QString& output,
+                                 domain::ConflictResolution onConflict) {
+        util::UseLoggingMessagePattern();
+        const int exitCode = model::PboMerger::run(files, output, onConflict, cout, cerr);
+        return exitCode;
     }
 
     int RunWithCliOptions(int argc, char* argv[]) {
@@ -43,6 +185,10 @@ namespace pboman3 {
             const shared_ptr<CommandLine::Result> commandLine = cmd.build();
             CLI11_PARSE(cli, argc, argv)
 
+            const QString tracePath = GetTracePath(*commandLine);
+            if (!tracePath.isEmpty())
+                util::Tracer::start();
+
             if (commandLine->pack.hasBeenSet()) {
                 QString outputDir;
                 if (commandLine->pack.hasOutputPath())
@@ -51,7 +197,8 @@ namespace pboman3 {
                     outputDir = QDir::currentPath();
 
                 const QStringList folders = CommandLine::toQt(commandLine->pack.folders);
-                exitCode = RunConsolePackOperation(folders, outputDir);
+                exitCode = RunConsolePackOperation(folders, outputDir, commandLine->pack.jobs,
+                                                   GetStatsFormat(commandLine->pack));
             } else if (commandLine->unpack.hasBeenSet()) {
                 QString outputDir;
                 if (commandLine->unpack.hasOutputPath())
@@ -60,12 +207,43 @@ namespace pboman3 {
                     outputDir = QDir::currentPath();
 
                 const QStringList files = CommandLine::toQt(commandLine->unpack.files);
-                exitCode = RunConsoleUnpackOperation(files, outputDir);   
+                io::PboEntryFilter filter;
+                if (GetEntryFilter(commandLine->unpack, filter))
+                    exitCode = RunConsoleUnpackOperation(files, outputDir, commandLine->unpack.jobs,
+                                                         GetStatsFormat(commandLine->unpack), filter);
+                else
+                    exitCode = 1;
+            } else if (commandLine->list.hasBeenSet()) {
+                const QStringList files = CommandLine::toQt(commandLine->list.files);
+                exitCode = RunConsoleListOperation(files, commandLine->list.json(), commandLine->list.jobs);
+            } else if (commandLine->cat.hasBeenSet()) {
+                exitCode = RunConsoleCatOperation(CommandLine::toQt(commandLine->cat.file),
+                                                  CommandLine::toQt(commandLine->cat.entry));
+            } else if (commandLine->verify.hasBeenSet()) {
+                const QStringList files = CommandLine::toQt(commandLine->verify.files);
+                exitCode = RunConsoleVerifyOperation(files, commandLine->verify.jobs);
+            } else if (commandLine->diff.hasBeenSet()) {
+                exitCode = RunConsoleDiffOperation(CommandLine::toQt(commandLine->diff.fileA),
+                                                   CommandLine::toQt(commandLine->diff.fileB));
+            } else if (commandLine->recompress.hasBeenSet()) {
+                const QString file = CommandLine::toQt(commandLine->recompress.file);
+                const QString output = commandLine->recompress.hasOutput()
+                                           ? CommandLine::toQt(commandLine->recompress.output)
+                                           : file;
+                exitCode = RunConsoleRecompressOperation(file, CommandLine::toQt(commandLine->recompress.rulesFile),
+                                                         output);
+            } else if (commandLine->merge.hasBeenSet()) {
+                const QStringList files = CommandLine::toQt(commandLine->merge.files);
+                exitCode = RunConsoleMergeOperation(files, CommandLine::toQt(commandLine->merge.output),
+                                                    GetConflictResolution(commandLine->merge));
             } else {
                 //should not normally get here; if did - CLI11 was misconfigured somewhere
                 cout << cli.help();
                 exitCode = 1;
             }
+
+            if (!tracePath.isEmpty() && !util::Tracer::stopAndWrite(tracePath))
+                cerr << "Could not write the trace file: " << tracePath.toStdString() << endl;
         return exitCode;
     }
 
@@ -13,7 +13,7 @@ namespace pboman3::domain {
         ~BinarySource() = default;
 
     public:
-        virtual void writeToPbo(QFileDevice* targetFile, const Cancel& cancel) = 0;
+        virtual void writeToPbo(QIODevice* target, const Cancel& cancel) = 0;
 
         virtual void writeToFs(QFileDevice* targetFile, const Cancel& cancel) = 0;
 
@@ -0,0 +1,74 @@
+#include "io/compressionpipeline.h"
+#include <QBuffer>
+#include <QTemporaryFile>
+#include <gtest/gtest.h>
+#include "io/bs/fslzhbinarysource.h"
+
+namespace pboman3::io::test {
+    TEST(CompressionPipelineTest, Take_Returns_Compressed_Nodes) {
+        QTemporaryFile source;
+        source.open();
+        source.write(QByteArray(100, 'a'));
+        source.close();
+
+        PboNode root("root", PboNodeType::Container, nullptr);
+        QList<PboNode*> nodes;
+        for (int i = 0; i < 10; i++) {
+            PboNode* node = root.createHierarchy(PboPath(QString("e%1.txt").arg(i)));
+            node->binarySource = QSharedPointer<BinarySource>(new FsLzhBinarySource(source.fileName()));
+            node->binarySource->open();
+            nodes.append(node);
+        }
+
+        QByteArray expectedBytes;
+        QBuffer expected(&expectedBytes);
+        expected.open(QIODeviceBase::WriteOnly);
+        nodes.at(0)->binarySource->writeToPbo(&expected, []() { return false; });
+
+        const Cancel cancel = []() { return false; };
+        CompressionPipeline pipeline(nodes, 2, 1024, cancel);
+        for (const PboNode* node : nodes) {
+            const QSharedPointer<QByteArray> data = pipeline.take(node);
+            ASSERT_TRUE(data);
+            ASSERT_EQ(*data, expectedBytes);
+        }
+    }
+
+    TEST(CompressionPipelineTest, Take_Returns_Nodes_Larger_Than_Budget) {
+        QTemporaryFile source;
+        source.open();
+        source.write(QByteArray(100, 'a'));
+        source.close();
+
+        PboNode root("root", PboNodeType::Container, nullptr);
+        QList<PboNode*> nodes;
+        for (int i = 0; i < 5; i++) {
+            PboNode* node = root.createHierarchy(PboPath(QString("e%1.txt").arg(i)));
+            node->binarySource = QSharedPointer<BinarySource>(new FsLzhBinarySource(source.fileName()));
+            node->binarySource->open();
+            nodes.append(node);
+        }
+
+        //each node alone is over the budget, so they go one at a time
+        const Cancel cancel = []() { return false; };
+        CompressionPipeline pipeline(nodes, 4, 50, cancel);
+        for (const PboNode* node : nodes)
+            ASSERT_TRUE(pipeline.take(node));
+    }
+
+    TEST(CompressionPipelineTest, Take_Returns_Null_If_Cancelled) {
+        QTemporaryFile source;
+        source.open();
+        source.write(QByteArray(100, 'a'));
+        source.close();
+
+        PboNode root("root", PboNodeType::Container, nullptr);
+        PboNode* node = root.createHierarchy(PboPath("e1.txt"));
+        node->binarySource = QSharedPointer<BinarySource>(new FsLzhBinarySource(source.fileName()));
+        node->binarySource->open();
+
+        const Cancel cancel = []() { return true; };
+        CompressionPipeline pipeline(QList({node}), 2, 1024, cancel);
+        ASSERT_FALSE(pipeline.take(node));
+    }
+}
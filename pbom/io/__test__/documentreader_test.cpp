@@ -79,4 +79,55 @@ namespace pboman3::io::test {
         ASSERT_EQ(bs2->getInfo().dataSize, 10);
         ASSERT_EQ(bs2->getInfo().dataOffset, 106);//bs1.dataOffset + bs1.dataSize
     }
+
+    TEST(PboReaderTest, Read_Reads_Filtered_Entries) {
+        //build a mock pbo file
+        QTemporaryFile t;
+        t.open();
+
+        PboFile p(t.fileName());
+        p.open(QIODeviceBase::WriteOnly);
+        const PboHeaderIO io(&p);
+
+        const PboNodeEntity e1("f1\\e1.sqf", PboPackingMethod::Uncompressed, 5, 0, 0, 5);
+        const PboNodeEntity e2("config.cpp", PboPackingMethod::Uncompressed, 10, 0, 0, 10);
+        const PboNodeEntity e3("f2\\e3.sqf", PboPackingMethod::Uncompressed, 15, 0, 0, 15);
+
+        io.writeEntry(PboNodeEntity::makeSignature());
+        io.writeHeader(PboHeaderEntity::makeBoundary());
+        io.writeEntry(e1);
+        io.writeEntry(e2);
+        io.writeEntry(e3);
+        io.writeEntry(PboNodeEntity::makeBoundary());
+        const qint64 dataStart = p.pos();
+        p.write(QByteArray(e1.dataSize() + e2.dataSize() + e3.dataSize(), 1));
+        p.write(QByteArray(1, 0));
+        p.write(QByteArray(20, 5));
+
+        p.close();
+        t.close();
+
+        //call the method
+        PboEntryFilter filter;
+        filter.addInclude("config.cpp");
+        filter.addInclude("f2/*");
+
+        const DocumentReader reader(t.fileName());
+        const QSharedPointer<PboDocument> document = reader.read(filter);
+
+        //verify the results
+        ASSERT_EQ(document->root()->count(), 2);
+
+        const PboNode* config = document->root()->get(PboPath("config.cpp"));
+        ASSERT_TRUE(config);
+        const auto bs2 = dynamic_cast<PboBinarySource*>(config->binarySource.get());
+        ASSERT_EQ(bs2->getInfo().dataOffset, dataStart + e1.dataSize());
+
+        const PboNode* e3Node = document->root()->get(PboPath("f2/e3.sqf"));
+        ASSERT_TRUE(e3Node);
+        const auto bs3 = dynamic_cast<PboBinarySource*>(e3Node->binarySource.get());
+        ASSERT_EQ(bs3->getInfo().dataOffset, dataStart + e1.dataSize() + e2.dataSize());
+
+        ASSERT_FALSE(document->root()->get(PboPath("f1/e1.sqf")));
+    }
 }
@@ -5,7 +5,9 @@
 #include "domain/pbodocument.h"
 #include "domain/documentheaderstransaction.h"
 #include "io/pboheaderreader.h"
+#include "io/documentreader.h"
 #include "io/bs/fsrawbinarysource.h"
+#include "io/bs/fslzhbinarysource.h"
 
 namespace pboman3::io::test {
     using namespace domain;
@@ -281,4 +283,116 @@ namespace pboman3::io::test {
         ASSERT_EQ(QFileInfo(existingFile.fileName() + ".bak").size(), 12);//the original file
     }
 
+
+    TEST(DocumentWriterTest, Write_Copies_Contiguous_Entries_Of_Existing_Pbo) {
+        //mock files contents
+        const QByteArray mockContent1(15, 1);
+        QTemporaryFile e1;
+        e1.open();
+        e1.write(mockContent1);
+        e1.close();
+
+        const QByteArray mockContent2(10, 2);
+        QTemporaryFile e2;
+        e2.open();
+        e2.write(mockContent2);
+        e2.close();
+
+        const QByteArray mockContent3(7, 3);
+        QTemporaryFile e3;
+        e3.open();
+        e3.write(mockContent3);
+        e3.close();
+
+        //the original pbo
+        PboDocument document("file.pbo");
+        PboNode* n1 = document.root()->createHierarchy(PboPath("e1.txt"));
+        n1->binarySource = QSharedPointer<BinarySource>(new FsRawBinarySource(e1.fileName()));
+        n1->binarySource->open();
+        PboNode* n2 = document.root()->createHierarchy(PboPath("f2/e2.txt"));
+        n2->binarySource = QSharedPointer<BinarySource>(new FsRawBinarySource(e2.fileName()));
+        n2->binarySource->open();
+        PboNode* n3 = document.root()->createHierarchy(PboPath("f2/e3.txt"));
+        n3->binarySource = QSharedPointer<BinarySource>(new FsRawBinarySource(e3.fileName()));
+        n3->binarySource->open();
+
+        const QTemporaryDir temp;
+        const QString origPath = temp.filePath("orig.pbo");
+        DocumentWriter(origPath).write(&document, []() { return false; });
+
+        //read the pbo back and write it to a new place, its entries are backed by the original pbo ranges
+        const QSharedPointer<PboDocument> existing = DocumentReader(origPath).read();
+        const QString copyPath = temp.filePath("copy.pbo");
+        DocumentWriter(copyPath).write(existing.get(), []() { return false; });
+
+        //the copy is identical to the original
+        QFile orig(origPath);
+        orig.open(QIODeviceBase::ReadOnly);
+        QFile copy(copyPath);
+        copy.open(QIODeviceBase::ReadOnly);
+        ASSERT_EQ(copy.readAll(), orig.readAll());
+
+        //the copy entries point to the correct data
+        PboFile pbo(copyPath);
+        pbo.open(QIODeviceBase::ReadOnly);
+        const PboFileHeader header = PboHeaderReader::readFileHeader(&pbo);
+        ASSERT_EQ(header.entries.count(), 3);
+        ASSERT_EQ(header.entries.at(0)->dataSize(), mockContent2.size());
+        ASSERT_EQ(header.entries.at(1)->dataSize(), mockContent3.size());
+        ASSERT_EQ(header.entries.at(2)->dataSize(), mockContent1.size());
+
+        pbo.seek(header.dataBlockStart + mockContent2.size());
+        QByteArray contents;
+        contents.resize(mockContent3.size());
+        pbo.read(contents.data(), contents.size());
+        ASSERT_EQ(contents, mockContent3);
+    }
+
+    TEST(DocumentWriterTest, Write_Compresses_Entries_In_Parallel) {
+        //mock files contents
+        QList<QSharedPointer<QTemporaryFile>> files;
+        for (int i = 0; i < 5; i++) {
+            const auto file = QSharedPointer<QTemporaryFile>::create();
+            file->open();
+            file->write(QByteArray(100 + i * 10, static_cast<char>('a' + i)));
+            file->close();
+            files.append(file);
+        }
+
+        const auto makeDocument = [&files](PboDocument& document) {
+            for (int i = 0; i < files.count(); i++) {
+                PboNode* n = document.root()->createHierarchy(PboPath(QString("e%1.txt").arg(i)));
+                n->binarySource = QSharedPointer<BinarySource>(new FsLzhBinarySource(files.at(i)->fileName()));
+                n->binarySource->open();
+            }
+        };
+
+        const QTemporaryDir temp;
+
+        //the pbo compressed in parallel
+        PboDocument document("file.pbo");
+        makeDocument(document);
+        DocumentWriter(temp.filePath("file.pbo")).write(&document, []() { return false; });
+
+        //the entries are in place and each of them is the same as compressed on its own
+        PboFile pbo(temp.filePath("file.pbo"));
+        pbo.open(QIODeviceBase::ReadOnly);
+        const PboFileHeader header = PboHeaderReader::readFileHeader(&pbo);
+        ASSERT_EQ(header.entries.count(), files.count());
+
+        pbo.seek(header.dataBlockStart);
+        for (int i = 0; i < files.count(); i++) {
+            ASSERT_EQ(header.entries.at(i)->fileName(), QString("e%1.txt").arg(i));
+
+            QTemporaryFile expected;
+            expected.open();
+            FsLzhBinarySource bs(files.at(i)->fileName());
+            bs.open();
+            bs.writeToPbo(&expected, []() { return false; });
+            expected.seek(0);
+
+            ASSERT_EQ(header.entries.at(i)->dataSize(), expected.size());
+            ASSERT_EQ(pbo.read(header.entries.at(i)->dataSize()), expected.readAll());
+        }
+    }
 }
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <QTemporaryFile>
+#include "io/pboentryfilter.h"
+
+namespace pboman3::io::test {
+    TEST(PboEntryFilterTest, Matches_Everything_If_Empty) {
+        const PboEntryFilter filter;
+
+        ASSERT_TRUE(filter.isEmpty());
+        ASSERT_TRUE(filter.matches(PboPath("config.cpp")));
+        ASSERT_TRUE(filter.matches(PboPath("f1/f2/e1.sqf")));
+    }
+
+    struct GlobParam {
+        const QString glob;
+        const QString path;
+        const bool expected;
+    };
+
+    class IncludeTest : public testing::TestWithParam<GlobParam> {
+    };
+
+    TEST_P(IncludeTest, Matches_Include_Glob) {
+        PboEntryFilter filter;
+        filter.addInclude(GetParam().glob);
+
+        ASSERT_EQ(filter.matches(PboPath(GetParam().path)), GetParam().expected);
+    }
+
+    INSTANTIATE_TEST_SUITE_P(PboEntryFilterTest, IncludeTest, testing::Values(
+                                 GlobParam{"config.cpp", "config.cpp", true},
+                                 GlobParam{"config.cpp", "f1/config.cpp", true},
+                                 GlobParam{"CONFIG.cpp", "f1/Config.CPP", true},
+                                 GlobParam{"config.cpp", "config.cpp.bak", false},
+                                 GlobParam{"*.sqf", "f1/f2/e1.sqf", true},
+                                 GlobParam{"*.sqf", "f1/f2/e1.sqs", false},
+                                 GlobParam{"e?.sqf", "e1.sqf", true},
+                                 GlobParam{"e?.sqf", "e12.sqf", false},
+                                 GlobParam{"f1/*.sqf", "f1/e1.sqf", true},
+                                 GlobParam{"f1/*.sqf", "f1/f2/e1.sqf", false},
+                                 GlobParam{"f1\\*.sqf", "f1/e1.sqf", true},
+                                 GlobParam{"f1/**", "f1/f2/e1.sqf", true},
+                                 GlobParam{"f1/**/e1.sqf", "f1/e1.sqf", true},
+                                 GlobParam{"f1/**/e1.sqf", "f1/f2/f3/e1.sqf", true},
+                                 GlobParam{"f1/**/e1.sqf", "f2/e1.sqf", false},
+                                 GlobParam{"f(1).sqf", "f(1).sqf", true},
+                                 GlobParam{"f(1).sqf", "f1.sqf", false}
+                             ));
+
+    TEST(PboEntryFilterTest, Matches_Excludes_Over_Includes) {
+        PboEntryFilter filter;
+        filter.addInclude("*.sqf");
+        filter.addExclude("f1/**");
+
+        ASSERT_TRUE(filter.matches(PboPath("e1.sqf")));
+        ASSERT_TRUE(filter.matches(PboPath("f2/e1.sqf")));
+        ASSERT_FALSE(filter.matches(PboPath("f1/e1.sqf")));
+        ASSERT_FALSE(filter.matches(PboPath("e1.sqs")));
+    }
+
+    TEST(PboEntryFilterTest, Matches_Only_Excludes) {
+        PboEntryFilter filter;
+        filter.addExclude("*.paa");
+
+        ASSERT_TRUE(filter.matches(PboPath("f1/e1.sqf")));
+        ASSERT_FALSE(filter.matches(PboPath("f1/e1.paa")));
+    }
+
+    TEST(PboEntryFilterTest, Matches_Exact_Paths) {
+        PboEntryFilter filter;
+        filter.addPath("f1\\e1.sqf");
+        filter.addPath("/Config.cpp");
+
+        ASSERT_TRUE(filter.matches(PboPath("f1/e1.sqf")));
+        ASSERT_TRUE(filter.matches(PboPath("config.cpp")));
+        ASSERT_FALSE(filter.matches(PboPath("e1.sqf")));
+        ASSERT_FALSE(filter.matches(PboPath("f2/config.cpp")));
+    }
+
+    TEST(PboEntryFilterTest, AddPathsFrom_Reads_File) {
+        QTemporaryFile t;
+        t.open();
+        t.write("f1/e1.sqf\r\n\r\n  config.cpp  \n");
+        t.close();
+
+        PboEntryFilter filter;
+        ASSERT_TRUE(filter.addPathsFrom(t.fileName()));
+
+        ASSERT_TRUE(filter.matches(PboPath("f1/e1.sqf")));
+        ASSERT_TRUE(filter.matches(PboPath("config.cpp")));
+        ASSERT_FALSE(filter.matches(PboPath("e2.sqf")));
+    }
+
+    TEST(PboEntryFilterTest, AddPathsFrom_Returns_False_If_No_File) {
+        PboEntryFilter filter;
+        ASSERT_FALSE(filter.addPathsFrom("non-existing-file.txt"));
+    }
+
+    TEST(PboEntryFilterTest, AddPathsFrom_Returns_False_If_No_Paths) {
+        QTemporaryFile t;
+        t.open();
+        t.write("\r\n   \n\n");
+        t.close();
+
+        PboEntryFilter filter;
+        ASSERT_FALSE(filter.addPathsFrom(t.fileName()));
+        ASSERT_TRUE(filter.isEmpty());
+    }
+}
@@ -76,6 +76,29 @@ namespace pboman3::io::test {
         ASSERT_EQ(p.pos(), 0);
     }
 
+    TEST(PboFileTest, ReadCString_Reads_Strings_Longer_Than_A_Chunk) {
+        const QByteArray longString(1000, 'a');
+
+        QByteArray z;
+        z.append(longString);
+        z.append(static_cast<char>(0));
+        z.append("tail");
+
+        QTemporaryFile t;
+        ASSERT_TRUE(t.open());
+        t.write(z);
+        t.close();
+
+        PboFile p(t.fileName());
+        p.open(QIODeviceBase::ReadOnly);
+
+        QString s1;
+        const int l1 = p.readCString(s1);
+        ASSERT_EQ(s1, QString(longString));
+        ASSERT_EQ(l1, 1001);
+        ASSERT_EQ(p.pos(), 1001);
+    }
+
     TEST(PboFileTest, WriteCString_Writes_Zero_Terminated_String) {
         QTemporaryFile t;
         ASSERT_TRUE(t.open());
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include "io/pbostreamreader.h"
+#include <QBuffer>
+#include <QTemporaryDir>
+#include "testpbobuilder.h"
+#include "io/pbofileformatexception.h"
+#include "io/lzh/lzh.h"
+
+namespace pboman3::io::test {
+    class PboStreamReaderTest : public testing::Test {
+    protected:
+        QTemporaryDir temp_;
+        QByteArray pbo_;
+        QByteArray packed_;
+        QByteArray raw_;
+
+        void SetUp() override {
+            for (int i = 0; i < 500; i++)
+                packed_.append(QByteArray::number(i % 13)).append(" some repeating text\r\n");
+            raw_ = QByteArray(100, 5);
+
+            const QString pboPath = TestPboBuilder(temp_.path())
+                                    .addHeader("prefix", "some\\prefix")
+                                    .addEntry("f1/e1.txt", packed_, true)
+                                    .addEntry("e2.bin", raw_)
+                                    .write("file.pbo");
+
+            QFile pbo(pboPath);
+            pbo.open(QIODeviceBase::ReadOnly);
+            pbo_ = pbo.readAll();
+            pbo.close();
+        }
+    };
+
+    TEST_F(PboStreamReaderTest, ReadHeader_Reads_Same_As_HeaderReader) {
+        QBuffer source(&pbo_);
+        source.open(QIODeviceBase::ReadOnly);
+
+        PboStreamReader reader(&source, 16);
+        const PboFileHeader header = reader.readHeader();
+
+        PboFile file(temp_.filePath("file.pbo"));
+        file.open(QIODeviceBase::ReadOnly);
+        const PboFileHeader expected = PboHeaderReader::readFileHeader(&file);
+
+        ASSERT_EQ(header.headers.count(), 1);
+        ASSERT_EQ(header.headers.at(0)->name, "prefix");
+        ASSERT_EQ(header.headers.at(0)->value, "some\\prefix");
+        ASSERT_EQ(header.entries.count(), expected.entries.count());
+        for (qsizetype i = 0; i < expected.entries.count(); i++) {
+            ASSERT_EQ(header.entries.at(i)->fileName(), expected.entries.at(i)->fileName());
+            ASSERT_EQ(header.entries.at(i)->packingMethod(), expected.entries.at(i)->packingMethod());
+            ASSERT_EQ(header.entries.at(i)->dataSize(), expected.entries.at(i)->dataSize());
+        }
+        ASSERT_EQ(header.dataBlockStart, expected.dataBlockStart);
+    }
+
+    TEST_F(PboStreamReaderTest, ReadData_Reads_Entries_And_Verifies_Signature) {
+        QBuffer source(&pbo_);
+        source.open(QIODeviceBase::ReadOnly);
+
+        PboStreamReader reader(&source, 16);
+        const PboFileHeader header = reader.readHeader();
+
+        QByteArray contents;
+        for (const QSharedPointer<PboNodeEntity>& entry : header.entries) {
+            if (entry->packingMethod() == PboPackingMethod::Packed) {
+                QByteArray packed = reader.readData(entry->dataSize());
+                QBuffer packedSource(&packed);
+                packedSource.open(QIODeviceBase::ReadOnly);
+                QBuffer target(&contents);
+                target.open(QIODeviceBase::WriteOnly);
+                Lzh::decompress(&packedSource, &target, entry->originalSize(), []() { return false; });
+                ASSERT_EQ(contents, packed_);
+            } else {
+                QBuffer target(&contents);
+                target.open(QIODeviceBase::WriteOnly);
+                reader.readData(&target, entry->dataSize(), []() { return false; });
+                ASSERT_EQ(contents, raw_);
+            }
+        }
+
+        QByteArray signature;
+        ASSERT_TRUE(reader.verifySignature(&signature));
+        ASSERT_EQ(signature, pbo_.right(20));
+    }
+
+    TEST_F(PboStreamReaderTest, VerifySignature_Returns_False_If_Data_Corrupted) {
+        pbo_[pbo_.size() - 30] = static_cast<char>(pbo_.at(pbo_.size() - 30) + 1);
+        QBuffer source(&pbo_);
+        source.open(QIODeviceBase::ReadOnly);
+
+        PboStreamReader reader(&source);
+        const PboFileHeader header = reader.readHeader();
+        for (const QSharedPointer<PboNodeEntity>& entry : header.entries)
+            reader.skipData(entry->dataSize(), []() { return false; });
+
+        QByteArray signature;
+        ASSERT_FALSE(reader.verifySignature(&signature));
+    }
+
+    TEST_F(PboStreamReaderTest, VerifySignature_Returns_False_If_Stream_Truncated) {
+        pbo_.chop(10);
+        QBuffer source(&pbo_);
+        source.open(QIODeviceBase::ReadOnly);
+
+        PboStreamReader reader(&source);
+        const PboFileHeader header = reader.readHeader();
+        for (const QSharedPointer<PboNodeEntity>& entry : header.entries)
+            reader.skipData(entry->dataSize(), []() { return false; });
+
+        QByteArray signature;
+        ASSERT_FALSE(reader.verifySignature(&signature));
+    }
+
+    TEST_F(PboStreamReaderTest, ReadHeader_Throws_If_Stream_Ends_Within_Header) {
+        pbo_.truncate(30);
+        QBuffer source(&pbo_);
+        source.open(QIODeviceBase::ReadOnly);
+
+        PboStreamReader reader(&source);
+        ASSERT_THROW(reader.readHeader(), PboFileFormatException);
+    }
+}
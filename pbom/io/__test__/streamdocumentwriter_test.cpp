@@ -0,0 +1,79 @@
+#include "io/streamdocumentwriter.h"
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QTemporaryDir>
+#include <gtest/gtest.h>
+#include "testpbobuilder.h"
+#include "domain/pbodocument.h"
+#include "io/documentwriter.h"
+
+namespace pboman3::io::test {
+    using namespace domain;
+
+    class StreamDocumentWriterTest : public testing::Test {
+    protected:
+        QTemporaryDir temp_;
+        PboDocument document_{"file.pbo"};
+
+        void SetUp() override {
+            QByteArray text;
+            for (int i = 0; i < 300; i++)
+                text.append(QByteArray::number(i % 11)).append(" some repeating text\r\n");
+
+            TestPboBuilder(temp_.path())
+                .addHeader("h1", "v1")
+                .addHeader("prefix", "some\\prefix")
+                .addEntry("e1.txt", QByteArray(15, 1))
+                .addEntry("f2/e2.sqf", text, true)
+                .addEntry("f2/e3.sqf", text.left(1000), true)
+                .addEntry("f3/e4.bin", QByteArray(10, 2))
+                .fill(&document_);
+        }
+    };
+
+    TEST_F(StreamDocumentWriterTest, Write_Writes_Same_Bytes_As_DocumentWriter) {
+        QBuffer stream;
+        stream.open(QIODeviceBase::WriteOnly);
+        StreamDocumentWriter streamWriter(&stream);
+        streamWriter.write(&document_, []() { return false; });
+        const QByteArray streamSignature = document_.signature();
+
+        //DocumentWriter re-points the binary sources to the written file, so it goes second
+        const QString filePath = temp_.filePath("file.pbo");
+        DocumentWriter fileWriter(filePath);
+        fileWriter.write(&document_, []() { return false; });
+
+        QFile file(filePath);
+        file.open(QIODeviceBase::ReadOnly);
+        const QByteArray expected = file.readAll();
+        file.close();
+
+        ASSERT_EQ(stream.data(), expected);
+        ASSERT_EQ(streamSignature, document_.signature());
+    }
+
+    TEST_F(StreamDocumentWriterTest, Write_Writes_Valid_Signature) {
+        QBuffer stream;
+        stream.open(QIODeviceBase::WriteOnly);
+        StreamDocumentWriter writer(&stream);
+        writer.write(&document_, []() { return false; });
+
+        const QByteArray& bytes = stream.data();
+        const QByteArray signature = bytes.right(20);
+        ASSERT_EQ(bytes.at(bytes.size() - 21), 0);
+        ASSERT_EQ(QCryptographicHash::hash(bytes.left(bytes.size() - 21), QCryptographicHash::Sha1), signature);
+    }
+
+    TEST_F(StreamDocumentWriterTest, Write_Reports_Each_Entry) {
+        QBuffer stream;
+        stream.open(QIODeviceBase::WriteOnly);
+        StreamDocumentWriter writer(&stream);
+
+        int written = 0;
+        std::function onEntryWritten = [&written]() { written++; };
+        writer.setOnEntryWritten(&onEntryWritten);
+        writer.write(&document_, []() { return false; });
+
+        ASSERT_EQ(written, 4);
+    }
+}
@@ -0,0 +1,61 @@
+#include "testpbobuilder.h"
+#include <QDateTime>
+#include <QTemporaryFile>
+#include "domain/documentheaderstransaction.h"
+#include "io/documentwriter.h"
+#include "io/bs/fslzhbinarysource.h"
+#include "io/bs/fsrawbinarysource.h"
+
+namespace pboman3::io::test {
+    TestPboBuilder::TestPboBuilder(const QString& folder)
+        : folder_(folder) {
+    }
+
+    TestPboBuilder& TestPboBuilder::addHeader(const QString& name, const QString& value) {
+        headers_.append(QPair(name, value));
+        return *this;
+    }
+
+    TestPboBuilder& TestPboBuilder::addEntry(const QString& path, const QByteArray& content, bool compressed,
+                                             qint64 timestamp) {
+        //several builders might share the folder, so the file names are made unique
+        QTemporaryFile file(folder_.filePath("entry.XXXXXX"));
+        file.setAutoRemove(false);
+        file.open();
+        file.write(content);
+        file.flush();
+        if (timestamp)
+            file.setFileTime(QDateTime::fromSecsSinceEpoch(timestamp), QFileDevice::FileModificationTime);
+        file.close();
+
+        entries_.append(Entry{path, file.fileName(), compressed});
+        return *this;
+    }
+
+    void TestPboBuilder::fill(PboDocument* document) const {
+        if (!headers_.isEmpty()) {
+            const QSharedPointer<DocumentHeadersTransaction> tran = document->headers()->beginTransaction();
+            for (const auto& [name, value] : headers_)
+                tran->add(name, value);
+            tran->commit();
+        }
+
+        for (const Entry& entry : entries_) {
+            PboNode* node = document->root()->createHierarchy(PboPath(entry.path));
+            node->binarySource = entry.compressed
+                                     ? QSharedPointer<BinarySource>(new FsLzhBinarySource(entry.filePath))
+                                     : QSharedPointer<BinarySource>(new FsRawBinarySource(entry.filePath));
+            node->binarySource->open();
+        }
+    }
+
+    QString TestPboBuilder::write(const QString& fileName) const {
+        PboDocument document(fileName);
+        fill(&document);
+
+        const QString pboPath = folder_.filePath(fileName);
+        DocumentWriter writer(pboPath);
+        writer.write(&document, []() { return false; });
+        return pboPath;
+    }
+}
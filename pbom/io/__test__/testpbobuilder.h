@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QDir>
+#include <QList>
+#include <QPair>
+#include "domain/pbodocument.h"
+
+namespace pboman3::io::test {
+    using namespace domain;
+
+    //builds the PBO documents and files the tests work with, the entry contents are stored as files in the folder
+    class TestPboBuilder {
+    public:
+        explicit TestPboBuilder(const QString& folder);
+
+        TestPboBuilder& addHeader(const QString& name, const QString& value);
+
+        //the timestamp of 0 leaves the file time as is
+        TestPboBuilder& addEntry(const QString& path, const QByteArray& content, bool compressed = false,
+                                 qint64 timestamp = 0);
+
+        //adds the headers and the entries to the document
+        void fill(PboDocument* document) const;
+
+        //writes the PBO into the folder, returns its path
+        QString write(const QString& fileName) const;
+
+    private:
+        struct Entry {
+            QString path;
+            QString filePath;
+            bool compressed;
+        };
+
+        QDir folder_;
+        QList<QPair<QString, QString>> headers_;
+        QList<Entry> entries_;
+    };
+}
@@ -47,6 +47,58 @@ namespace pboman3::io::test {
         ASSERT_THROW(fs.allocatePath(file, file->parentNode()), InvalidOperationException);
     }
 
+    TEST(NodeFileSystemTest, AllocatePath_Does_Not_Recreate_Folders_Known_Within_Operation) {
+        const QTemporaryDir dir;
+        const NodeFileSystem fs(QDir(dir.path()));
+
+        PboNode root("root", PboNodeType::Container, nullptr);
+        const PboNode* e1 = root.createHierarchy(PboPath("f1/e1.txt"));
+        const PboNode* e2 = root.createHierarchy(PboPath("f1/e2.txt"));
+
+        fs.allocatePath(e1);
+        ASSERT_TRUE(QDir(dir.filePath("f1")).removeRecursively());
+
+        //the folder is known to the instance, so it is not looked up again
+        const QString path = fs.allocatePath(e2);
+        ASSERT_EQ(dir.path() + "/f1/e2.txt", path);
+        ASSERT_FALSE(QFileInfo(path).dir().exists());
+
+        //the next operation looks it up again
+        fs.forgetFolders();
+        fs.allocatePath(e2);
+        ASSERT_TRUE(QFileInfo(path).dir().exists());
+    }
+
+    TEST(NodeFileSystemTest, AllocateFolders_Recreates_Folders_Deleted_After_Previous_Operation) {
+        const QTemporaryDir dir;
+        const NodeFileSystem fs(QDir(dir.path()));
+
+        PboNode root("root", PboNodeType::Container, nullptr);
+        const PboNode* e1 = root.createHierarchy(PboPath("f1/e1.txt"));
+
+        fs.allocateFolders(&root, QList({ e1 }));
+        ASSERT_TRUE(QDir(dir.filePath("f1")).removeRecursively());
+
+        fs.allocateFolders(&root, QList({ e1 }));
+        ASSERT_TRUE(QDir(dir.filePath("f1")).exists());
+    }
+
+    TEST(NodeFileSystemTest, AllocateFolders_Creates_Folders_For_All_Nodes) {
+        const QTemporaryDir dir;
+        const NodeFileSystem fs(QDir(dir.path()));
+
+        PboNode root("root", PboNodeType::Container, nullptr);
+        const PboNode* e1 = root.createHierarchy(PboPath("f1/e1.txt"));
+        const PboNode* e2 = root.createHierarchy(PboPath("f1/f2\t/e2.txt"));
+        const PboNode* e3 = root.createHierarchy(PboPath("e3.txt"));
+
+        fs.allocateFolders(&root, QList({ e1, e2, e3 }));
+
+        ASSERT_TRUE(QDir(dir.filePath("f1")).exists());
+        ASSERT_TRUE(QDir(dir.filePath("f1/f2%09")).exists());
+        ASSERT_FALSE(QFileInfo::exists(dir.filePath("e3.txt")));
+    }
+
     TEST(NodeFileSystemTest, ComposeAbsolutePath_Returns_Sanitized_Path) {
         const QTemporaryDir dir;
         const NodeFileSystem fs(QDir(dir.path()));
@@ -135,4 +135,86 @@ namespace pboman3::io::test {
         ASSERT_THROW(unpack.unpackSync(tree.get(PboPath("f2")), QList({ e1 }), []() { return false; }),
                      InvalidOperationException);
     }
+
+    TEST(UnpackBackendTest, UnpackSync_Extracts_In_Parallel) {
+        const QTemporaryDir dir;
+
+        QTemporaryFile t1;
+        t1.open();
+        t1.write(QByteArray(
+            "\xFFLorem Ip\xFFsum is s\xFFimply du\xFFmmy text\xFF of the \xFFprinting\xFF and typ\xEF"
+            "eset\x10\x02ind?ustry.\xFC\x1B\x00\x00", 84));
+        t1.close();
+
+        PboNode tree("tree.pbo", PboNodeType::Container, nullptr);
+        constexpr PboDataInfo dataInfo{74, 84, 0, 0, true};
+        for (int i = 0; i < 20; i++) {
+            PboNode* e = tree.createHierarchy(PboPath(QString("f%1/f/e%2.txt").arg(i % 3).arg(i)));
+            e->binarySource = QSharedPointer<BinarySource>(new PboBinarySource(t1.fileName(), dataInfo));
+            e->binarySource->open();
+        }
+
+        QList<PboNode*> list;
+        for (PboNode* node : tree)
+            list.append(node);
+
+        UnpackBackend unpack(QDir(dir.path()));
+        unpack.setThreadCount(4);
+        unpack.unpackSync(&tree, list, []() { return false; });
+
+        for (int i = 0; i < 20; i++) {
+            const QString filePath = dir.filePath(QString("f%1/f/e%2.txt").arg(i % 3).arg(i));
+            ASSERT_TRUE(QFile::exists(filePath));
+
+            QFile f(filePath);
+            f.open(QIODeviceBase::ReadOnly);
+            ASSERT_EQ(f.readAll(), QString("Lorem Ipsum is simply dummy text of the printing and typesetting industry."));
+            f.close();
+        }
+    }
+
+    TEST(UnpackBackendTest, UnpackSync_Throws_If_Root_Is_Invalid_In_Parallel) {
+        const QTemporaryDir dir;
+
+        PboNode tree("tree.pbo", PboNodeType::Container, nullptr);
+        PboNode* e1 = tree.createHierarchy(PboPath("f1/e1.txt"));
+        PboNode* e2 = tree.createHierarchy(PboPath("f1/e2.txt"));
+        tree.createHierarchy(PboPath("f2/e3.txt"));
+
+        UnpackBackend unpack(QDir(dir.path()));
+        unpack.setThreadCount(2);
+        ASSERT_THROW(unpack.unpackSync(tree.get(PboPath("f2")), QList({ e1, e2 }), []() { return false; }),
+                     InvalidOperationException);
+    }
+
+    class OrderRecordingUnpackBackend : public UnpackBackend {
+    public:
+        explicit OrderRecordingUnpackBackend(const QDir& folder)
+            : UnpackBackend(folder) {
+        }
+
+        mutable QStringList order;
+
+    protected:
+        void unpackFileNode(const PboNode* rootNode, const PboNode* childNode, const Cancel& cancel) const override {
+            order.append(childNode->title());
+        }
+    };
+
+    TEST(UnpackBackendTest, UnpackSync_Extracts_In_Data_Offset_Order) {
+        const QTemporaryDir dir;
+
+        PboNode tree("tree.pbo", PboNodeType::Container, nullptr);
+        PboNode* e1 = tree.createHierarchy(PboPath("a/e1.txt"));
+        e1->binarySource = QSharedPointer<BinarySource>(new PboBinarySource("file.pbo", PboDataInfo{0, 10, 30, 0, 0}));
+        PboNode* e2 = tree.createHierarchy(PboPath("b/e2.txt"));
+        e2->binarySource = QSharedPointer<BinarySource>(new PboBinarySource("file.pbo", PboDataInfo{0, 10, 10, 0, 0}));
+        PboNode* e3 = tree.createHierarchy(PboPath("e3.txt"));
+        e3->binarySource = QSharedPointer<BinarySource>(new PboBinarySource("file.pbo", PboDataInfo{0, 10, 20, 0, 0}));
+
+        OrderRecordingUnpackBackend unpack(QDir(dir.path()));
+        unpack.unpackSync(&tree, QList({ e1, e2, e3 }), []() { return false; });
+
+        ASSERT_EQ(unpack.order, QStringList({ "e2.txt", "e3.txt", "e1.txt" }));
+    }
 }
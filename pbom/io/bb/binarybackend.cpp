@@ -1,6 +1,7 @@
 #include "binarybackend.h"
 #include "unpackbackend.h"
 #include "io/diskaccessexception.h"
+#include "util/executionpools.h"
 #include "util/log.h"
 
 #define LOG(...) LOGGER("io/bb/BinaryBackend", __VA_ARGS__)
@@ -42,6 +43,7 @@ namespace pboman3::io {
     void BinaryBackend::unpackSync(const QDir& dest, const PboNode* rootNode, const QList<PboNode*>& childNodes,
                                    const Cancel& cancel) const {
         UnpackBackend unpack(dest);
+        unpack.setThreadCount(util::ExecutionPools::io()->maxThreadCount());
         unpack.unpackSync(rootNode, childNodes, cancel);
     }
 
@@ -26,22 +26,39 @@ namespace pboman3::io {
         assert(parent);
         assert(node);
 
-        QList<const PboNode*> parents;
-        parents.reserve(node->depth() - parent->depth());
+        const QList<const PboNode*> parents = getParents(parent, node);
+        QString path = allocatePath(parents, node);
 
-        const PboNode* p = node->parentNode();
-        while (p && p != parent) {
-            parents.prepend(p);
-            p = p->parentNode();
-        }
-        if (!p) {
-            LOG(critical, "The provided rootNode is not a real parent of the provided childNode")
-            throw InvalidOperationException("The provided rootNode is not a real parent of the provided childNode");
+        return path;
+    }
+
+    void NodeFileSystem::allocateFolders(const PboNode* parent, const QList<const PboNode*>& nodes) const {
+        assert(parent);
+
+        forgetFolders();
+
+        QSet<QString> folderPaths;
+        for (const PboNode* node : nodes) {
+            QString folderPath = composeFolderPath(getParents(parent, node));
+            if (!folderPath.isEmpty())
+                folderPaths.insert(std::move(folderPath));
         }
 
-        QString path = allocatePath(parents, node);
+        LOG(info, "Allocate", folderPaths.count(), "folders")
 
-        return path;
+        for (const QString& folderPath : folderPaths) {
+            try {
+                allocateFolder(folderPath);
+            } catch (const DiskAccessException& ex) {
+                //allocatePath() will report it for every node affected
+                LOG(warning, "Could not create the folder:", ex)
+            }
+        }
+    }
+
+    void NodeFileSystem::forgetFolders() const {
+        QMutexLocker locker(&knownFoldersMutex_);
+        knownFolders_.clear();
     }
 
     QString NodeFileSystem::composeAbsolutePath(const PboNode* node) const {
@@ -66,17 +83,58 @@ namespace pboman3::io {
         return parents;
     }
 
-    QString NodeFileSystem::allocatePath(const QList<const PboNode*>& parents, const PboNode* node) const {
-        QDir local(folder_);
+    QList<const PboNode*> NodeFileSystem::getParents(const PboNode* parent, const PboNode* node) const {
+        QList<const PboNode*> parents;
+        parents.reserve(node->depth() - parent->depth());
+
+        const PboNode* p = node->parentNode();
+        while (p && p != parent) {
+            parents.prepend(p);
+            p = p->parentNode();
+        }
+        if (!p) {
+            LOG(critical, "The provided rootNode is not a real parent of the provided childNode")
+            throw InvalidOperationException("The provided rootNode is not a real parent of the provided childNode");
+        }
+
+        return parents;
+    }
+
+    QString NodeFileSystem::composeFolderPath(const QList<const PboNode*>& parents) {
+        QString folderPath;
         for (const PboNode* par : parents) {
             SanitizedString title(par->title());
-            if (!QDir(local.filePath(title)).exists() && !local.mkdir(title))
-                throw DiskAccessException("Could not create the folder.", local.filePath(title));
-            local.cd(title);
+            if (!folderPath.isEmpty())
+                folderPath.append('/');
+            folderPath.append(title);
+        }
+        return folderPath;
+    }
+
+    void NodeFileSystem::allocateFolder(const QString& folderPath) const {
+        {
+            QMutexLocker locker(&knownFoldersMutex_);
+            if (knownFolders_.contains(folderPath))
+                return;
         }
 
+        //mkpath() succeeds if another thread has created the folder in the meantime
+        if (!folder_.mkpath(folderPath))
+            throw DiskAccessException("Could not create the folder.", folder_.filePath(folderPath));
+
+        QMutexLocker locker(&knownFoldersMutex_);
+        knownFolders_.insert(folderPath);
+    }
+
+    QString NodeFileSystem::allocatePath(const QList<const PboNode*>& parents, const PboNode* node) const {
+        const QString folderPath = composeFolderPath(parents);
         SanitizedString title(node->title());
-        return local.filePath(title);
+
+        if (folderPath.isEmpty())
+            return folder_.filePath(title);
+
+        allocateFolder(folderPath);
+        return folder_.filePath(folderPath + '/' + static_cast<const QString&>(title));
     }
 
     QString NodeFileSystem::composePath(const PboNode* node, const QString& rootPath) const {
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <QDir>
+#include <QMutex>
+#include <QSet>
 #include "domain/pbonode.h"
 
 namespace pboman3::io {
@@ -15,15 +17,31 @@ namespace pboman3::io {
 
         QString allocatePath(const PboNode* parent, const PboNode* node) const;
 
+        //creates the folders for all the nodes in one pass, so that allocatePath() does not touch the disk for them
+        //starts a new operation, the folders remembered by the previous ones are forgotten
+        void allocateFolders(const PboNode* parent, const QList<const PboNode*>& nodes) const;
+
+        //the created folders are remembered only within a single operation,
+        //as the user might delete them before the next one
+        void forgetFolders() const;
+
         QString composeAbsolutePath(const PboNode* node) const;
 
         QString composeRelativePath(const PboNode* node) const;
 
     private:
         QDir folder_;
+        mutable QSet<QString> knownFolders_;
+        mutable QMutex knownFoldersMutex_;
 
         QList<const PboNode*> getParents(const PboNode* node) const;
 
+        QList<const PboNode*> getParents(const PboNode* parent, const PboNode* node) const;
+
+        static QString composeFolderPath(const QList<const PboNode*>& parents);
+
+        void allocateFolder(const QString& folderPath) const;
+
         QString allocatePath(const QList<const PboNode*>& parents, const PboNode* node) const;
 
         QString composePath(const PboNode* node, const QString& rootPath) const;
@@ -17,6 +17,8 @@ namespace pboman3::io {
     }
 
     QList<QUrl> TempBackend::hddSync(const QList<PboNode*>& nodes, const Cancel& cancel) const {
+        nodeFileSystem_->forgetFolders();
+
         QList<QUrl> result;
         for (const PboNode* node : nodes) {
             QString path = node->nodeType() == PboNodeType::File
@@ -1,13 +1,29 @@
 #include "unpackbackend.h"
 #include <QDir>
+#include <QMutex>
+#include <QRunnable>
+#include <QSemaphore>
+#include <algorithm>
+#include <exception>
+#include <limits>
+#include <memory>
+#ifdef Q_OS_LINUX
+#include <fcntl.h>
+#endif
 #include "io/diskaccessexception.h"
+#include "io/bs/pbobinarysource.h"
 #include "exception.h"
+#include "util/executionpools.h"
 #include "util/log.h"
+#include "util/tracer.h"
 
 #define LOG(...) LOGGER("io/bb/UnpackBackend", __VA_ARGS__)
 
 namespace pboman3::io {
-    io::UnpackBackend::UnpackBackend(const QDir& folder) {
+    io::UnpackBackend::UnpackBackend(const QDir& folder)
+        : threadCount_(1),
+          subtasks_(nullptr),
+          stats_(nullptr) {
         if (!folder.exists())
             throw InvalidOperationException("The folder provided must exist");
         nodeFileSystem_ = QSharedPointer<NodeFileSystem>(new NodeFileSystem(folder));
@@ -17,47 +33,189 @@ namespace pboman3::io {
                                  const Cancel& cancel) {
         assert(rootNode);
 
-        LOG(info, "Unpack", childNodes.count(), "nodes")
-
+        QList<const PboNode*> fileNodes;
         for (const PboNode* childNode : childNodes) {
-            if (cancel()) {
-                LOG(info, "The extraction was cancelled - exiting")
-                break;
-            }
+            if (childNode->nodeType() == PboNodeType::File)
+                fileNodes.append(childNode);
+            else
+                collectFileNodes(childNode, fileNodes);
+        }
+
+        LOG(info, "Unpack", childNodes.count(), "nodes containing", fileNodes.count(), "files")
+
+        sortByDataOffset(fileNodes);
+        nodeFileSystem_->allocateFolders(rootNode, fileNodes);
 
-            unpackNode(rootNode, childNode, cancel);
+        if (subtasks_ && fileNodes.count() > 1)
+            unpackSubtasks(rootNode, fileNodes, cancel);
+        else if (threadCount_ > 1 && fileNodes.count() > 1)
+            unpackParallel(rootNode, fileNodes, cancel);
+        else
+            unpackSerial(rootNode, fileNodes, cancel);
+    }
+
+    void UnpackBackend::setThreadCount(int threadCount) {
+        assert(threadCount > 0);
+        threadCount_ = threadCount;
+    }
+
+    void UnpackBackend::setSubtaskQueue(SubtaskQueue* subtasks) {
+        subtasks_ = subtasks;
+    }
+
+    void UnpackBackend::setStats(TaskStats* stats) {
+        stats_ = stats;
+    }
+
+    void UnpackBackend::collectFileNodes(const PboNode* node, QList<const PboNode*>& result) const {
+        for (const PboNode* child : *node) {
+            if (child->nodeType() == PboNodeType::File)
+                result.append(child);
+            else
+                collectFileNodes(child, result);
         }
     }
 
-    void UnpackBackend::unpackNode(const PboNode* rootNode, const PboNode* childNode,
-                                   const Cancel& cancel) {
-        if (childNode->nodeType() == PboNodeType::File)
-            unpackFileNode(rootNode, childNode, cancel);
-        else
-            unpackFolderNode(rootNode, childNode, cancel);
+    void UnpackBackend::sortByDataOffset(QList<const PboNode*>& fileNodes) {
+        //read the data block of the PBO in a forward sweep instead of jumping around in the tree order,
+        //the nodes not backed by a PBO keep their relative order at the end
+        const auto offset = [](const PboNode* node) {
+            const auto* bs = dynamic_cast<PboBinarySource*>(node->binarySource.get());
+            return bs ? bs->getInfo().dataOffset : std::numeric_limits<qsizetype>::max();
+        };
+        std::stable_sort(fileNodes.begin(), fileNodes.end(), [&offset](const PboNode* a, const PboNode* b) {
+            return offset(a) < offset(b);
+        });
+    }
+
+    void UnpackBackend::prefetchNode(const QList<const PboNode*>& fileNodes, qsizetype index) {
+        if (index >= fileNodes.count())
+            return;
+        if (const auto* bs = dynamic_cast<PboBinarySource*>(fileNodes.at(index)->binarySource.get()))
+            bs->prefetch();
     }
 
-    void UnpackBackend::unpackFolderNode(const PboNode* rootNode, const PboNode* childNode,
-                                         const Cancel& cancel) {
-        for (const PboNode* child : *childNode) {
+    void UnpackBackend::unpackSerial(const PboNode* rootNode, const QList<const PboNode*>& fileNodes,
+                                     const Cancel& cancel) const {
+        prefetchNode(fileNodes, 0);
+        for (qsizetype i = 0; i < fileNodes.count(); i++) {
             if (cancel()) {
                 LOG(info, "The extraction was cancelled - exiting")
                 break;
             }
-            unpackNode(rootNode, child, cancel);
+
+            prefetchNode(fileNodes, i + 1);
+            extractNode(rootNode, fileNodes.at(i), cancel);
         }
     }
 
+    void UnpackBackend::unpackParallel(const PboNode* rootNode, const QList<const PboNode*>& fileNodes,
+                                       const Cancel& cancel) const {
+        //every node has a binary source with its own file handle, so the nodes can be extracted independently
+        const int numThreads = std::min(threadCount_, static_cast<int>(fileNodes.count()));
+        LOG(info, "Unpack in parallel using", numThreads, "threads")
+
+        QAtomicInt nextNode(0);
+        QAtomicInt failed(0);
+        QMutex errorMutex;
+        std::exception_ptr error;
+
+        const Cancel workerCancel = [&cancel, &failed]() {
+            return failed.loadAcquire() > 0 || cancel();
+        };
+
+        QSemaphore workersDone;
+        auto worker = [&]() {
+            try {
+                int index = nextNode.fetchAndAddRelaxed(1);
+                prefetchNode(fileNodes, index);
+                while (index < fileNodes.count() && !workerCancel()) {
+                    prefetchNode(fileNodes, index + numThreads); //the node this worker is likely to pick next
+                    extractNode(rootNode, fileNodes.at(index), workerCancel);
+                    index = nextNode.fetchAndAddRelaxed(1);
+                }
+            } catch (...) {
+                QMutexLocker locker(&errorMutex);
+                if (!error)
+                    error = std::current_exception();
+                failed.storeRelease(1);
+            }
+        };
+
+        //the io pool is shared with the rest of the app, so the workers are tracked one by one
+        QThreadPool* pool = util::ExecutionPools::io();
+        QList<std::unique_ptr<QRunnable>> workers;
+        workers.reserve(numThreads - 1);
+        for (int i = 0; i < numThreads - 1; i++) {
+            workers.emplace_back(QRunnable::create([&]() {
+                worker();
+                workersDone.release();
+            }));
+            workers.back()->setAutoDelete(false);
+            pool->start(workers.back().get());
+        }
+
+        worker(); //the calling thread does its share of work too
+
+        //the calling thread has claimed all the nodes left, the workers still queued in a busy pool are taken back
+        int started = 0;
+        for (const std::unique_ptr<QRunnable>& w : workers) {
+            if (!pool->tryTake(w.get()))
+                started++;
+        }
+        workersDone.acquire(started);
+
+        if (error) {
+            LOG(warning, "The extraction has failed")
+            std::rethrow_exception(error);
+        }
+
+        if (cancel())
+            LOG(info, "The extraction was cancelled - exiting")
+    }
+
+    void UnpackBackend::unpackSubtasks(const PboNode* rootNode, const QList<const PboNode*>& fileNodes,
+                                       const Cancel& cancel) const {
+        LOG(info, "Unpack as subtasks")
+
+        QList<SubtaskQueue::Subtask> subtasks;
+        subtasks.reserve(fileNodes.count());
+        for (qsizetype i = 0; i < fileNodes.count(); i++) {
+            subtasks.append([this, rootNode, &fileNodes, &cancel, i]() {
+                if (cancel())
+                    return;
+                prefetchNode(fileNodes, i + 1);
+                extractNode(rootNode, fileNodes.at(i), cancel);
+            });
+        }
+
+        subtasks_->execute(subtasks);
+
+        if (cancel())
+            LOG(info, "The extraction was cancelled - exiting")
+    }
+
+    void UnpackBackend::extractNode(const PboNode* rootNode, const PboNode* childNode, const Cancel& cancel) const {
+        //the nodes are extracted by several threads, so the calling thread alone would not show the CPU time spent
+        ScopedPhase phase(stats_, "extract");
+        if (const auto* bs = dynamic_cast<PboBinarySource*>(childNode->binarySource.get())) {
+            const PboDataInfo& info = bs->getInfo();
+            phase.addBytes(info.dataSize, info.compressed ? info.originalSize : info.dataSize);
+        }
+        unpackFileNode(rootNode, childNode, cancel);
+    }
+
     void UnpackBackend::unpackFileNode(const PboNode* rootNode, const PboNode* childNode,
                                        const Cancel& cancel) const {
         LOG(info, "Unpack the node", childNode->title())
+        TRACE_SCOPE("unpack", "write", childNode->title())
 
         const QString filePath = nodeFileSystem_->allocatePath(rootNode, childNode);
         if (cancel())
             return;
 
-        QFile file(filePath); //WriteOnly won't work for LZH unpacking
-        if (!file.open(QIODeviceBase::ReadWrite)) {
+        QFile file(filePath);
+        if (!file.open(QIODeviceBase::WriteOnly)) {
             LOG(critical, "Can not access the file:", file.fileName())
             throw DiskAccessException(
                 "Can not open the file. Check you have enough permissions and the file is not locked by another process.",
@@ -65,8 +223,50 @@ namespace pboman3::io {
         }
 
         LOG(info, "Writing to file system")
-        childNode->binarySource->writeToFs(&file, cancel);
+        writeContent(&file, childNode, cancel);
 
         file.close();
     }
+
+    void UnpackBackend::preallocate(QFileDevice* file, const PboNode* node) {
+        const auto* bs = dynamic_cast<PboBinarySource*>(node->binarySource.get());
+        if (!bs)
+            return;
+
+        //uncompressed PBO entries often have the original size of 0
+        //the original size of a compressed entry comes from the header as is, a damaged one must not make a huge file
+        const PboDataInfo& info = bs->getInfo();
+        const qint64 size = info.compressed
+                                ? std::min(static_cast<qint64>(info.originalSize),
+                                           static_cast<qint64>(info.dataSize) * maxCompressionRatio)
+                                : info.dataSize;
+        if (size <= 0)
+            return;
+
+#ifdef Q_OS_LINUX
+        if (posix_fallocate(file->handle(), 0, size) == 0)
+            return;
+#endif
+        //on Windows extending a file zero-fills it, which would write every entry twice
+#ifndef Q_OS_WIN
+        file->resize(size);
+#endif
+    }
+
+    void UnpackBackend::trim(QFileDevice* file) {
+        if (file->size() != file->pos())
+            file->resize(file->pos());
+    }
+
+    void UnpackBackend::writeContent(QFileDevice* file, const PboNode* node, const Cancel& cancel) {
+        preallocate(file, node);
+        try {
+            node->binarySource->writeToFs(file, cancel);
+        } catch (...) {
+            //a zero-filled tail would look like the valid contents
+            trim(file);
+            throw;
+        }
+        trim(file);
+    }
 }
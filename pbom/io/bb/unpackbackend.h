@@ -2,6 +2,8 @@
 
 #include "nodefilesystem.h"
 #include "domain/pbonode.h"
+#include "util/subtaskqueue.h"
+#include "util/taskstats.h"
 
 namespace pboman3::io {
     class UnpackBackend {
@@ -12,14 +14,50 @@ namespace pboman3::io {
 
         void unpackSync(const PboNode* rootNode, const QList<PboNode*>& childNodes, const Cancel& cancel);
 
+        //the number of threads extracting the files of the PBO concurrently, 1 means extract on the calling thread
+        //the calling thread is one of them, the rest are taken from the io pool
+        void setThreadCount(int threadCount);
+
+        //extract each file as a subtask of the queue instead, the threads helping the queue do the work
+        void setSubtaskQueue(SubtaskQueue* subtasks);
+
+        //when set, the extraction of each node is timed on the thread doing it
+        void setStats(TaskStats* stats);
+
     private:
-        void unpackNode(const PboNode* rootNode, const PboNode* childNode, const Cancel& cancel);
+        int threadCount_;
+        SubtaskQueue* subtasks_;
+        TaskStats* stats_;
+
+        void collectFileNodes(const PboNode* node, QList<const PboNode*>& result) const;
+
+        static void sortByDataOffset(QList<const PboNode*>& fileNodes);
+
+        static void prefetchNode(const QList<const PboNode*>& fileNodes, qsizetype index);
+
+        void unpackSerial(const PboNode* rootNode, const QList<const PboNode*>& fileNodes, const Cancel& cancel) const;
 
-        void unpackFolderNode(const PboNode* rootNode, const PboNode* childNode, const Cancel& cancel);
+        void unpackParallel(const PboNode* rootNode, const QList<const PboNode*>& fileNodes, const Cancel& cancel) const;
+
+        void unpackSubtasks(const PboNode* rootNode, const QList<const PboNode*>& fileNodes, const Cancel& cancel) const;
+
+        void extractNode(const PboNode* rootNode, const PboNode* childNode, const Cancel& cancel) const;
 
     protected:
         QSharedPointer<NodeFileSystem> nodeFileSystem_;
 
         virtual void unpackFileNode(const PboNode* rootNode, const PboNode* childNode, const Cancel& cancel) const;
+
+        //the LZSS tokens of a flag byte and 8 back references expand 17 bytes into 144 at most
+        static constexpr qint64 maxCompressionRatio = 9;
+
+        //reserves the disk space for the node contents, so the file does not grow through many small extensions
+        static void preallocate(QFileDevice* file, const PboNode* node);
+
+        //cuts off the reserved space the contents did not use
+        static void trim(QFileDevice* file);
+
+        //writes the node contents into the space reserved for them, the file is trimmed even if the writing throws
+        static void writeContent(QFileDevice* file, const PboNode* node, const Cancel& cancel);
     };
 }
@@ -8,6 +8,7 @@ namespace pboman3::io {
     UnpackTaskBackend::UnpackTaskBackend(const QDir& folder)
         : UnpackBackend(folder),
           onError_(nullptr),
+          onWarning_(nullptr),
           onProgress_(nullptr) {
     }
 
@@ -15,6 +16,10 @@ namespace pboman3::io {
         onError_ = callback;
     }
 
+    void UnpackTaskBackend::setOnWarning(std::function<void(const QString&)>* callback) {
+        onWarning_ = callback;
+    }
+
     void UnpackTaskBackend::setOnProgress(std::function<void()>* callback) {
         onProgress_ = callback;
     }
@@ -37,15 +42,15 @@ namespace pboman3::io {
         if (cancel())
             return;
 
-        QFile file(filePath); //WriteOnly won't work for LZH unpacking
-        if (file.exists()) {
-            LOG(info, "File already exists:", file.fileName())
-            error("File already exists | " + file.fileName());
-            progress();
-            return;
-        }
-
-        if (!file.open(QIODeviceBase::ReadWrite)) {
+        //the parallel workers might race for the same path, NewOnly lets only one of them create the file
+        QFile file(filePath);
+        if (!file.open(QIODeviceBase::WriteOnly | QIODeviceBase::NewOnly)) {
+            if (file.exists()) {
+                LOG(info, "File already exists:", file.fileName())
+                warning("File already exists | " + file.fileName());
+                progress();
+                return;
+            }
             LOG(warning, "Can not access the file:", file.fileName())
             error("Can could not write to the file | " + file.fileName());
             progress();
@@ -53,7 +58,7 @@ namespace pboman3::io {
         }
 
         LOG(debug, "Writing to file system")
-        childNode->binarySource->writeToFs(&file, cancel);
+        writeContent(&file, childNode, cancel);
 
         file.close();
 
@@ -62,12 +67,21 @@ namespace pboman3::io {
 
     void UnpackTaskBackend::error(const QString& error) const {
         if (onError_) {
+            QMutexLocker locker(&callbackMutex_);
             (*onError_)(error);
         }
     }
 
+    void UnpackTaskBackend::warning(const QString& warning) const {
+        if (onWarning_) {
+            QMutexLocker locker(&callbackMutex_);
+            (*onWarning_)(warning);
+        }
+    }
+
     void UnpackTaskBackend::progress() const {
         if (onProgress_) {
+            QMutexLocker locker(&callbackMutex_);
             (*onProgress_)();
         }
     }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QMutex>
 #include "unpackbackend.h"
 
 namespace pboman3::io {
@@ -10,6 +11,9 @@ namespace pboman3::io {
 
         void setOnError(std::function<void(const QString&)>* callback);
 
+        //the notices which do not mean the entry could not be unpacked, e.g. the file was already there
+        void setOnWarning(std::function<void(const QString&)>* callback);
+
         void setOnProgress(std::function<void()>* callback);
 
     protected:
@@ -17,10 +21,14 @@ namespace pboman3::io {
 
     private:
         std::function<void(const QString&)>* onError_;
+        std::function<void(const QString&)>* onWarning_;
         std::function<void()>* onProgress_;
+        mutable QMutex callbackMutex_; //the callbacks are invoked by several threads when unpacking in parallel
 
         void error(const QString& error) const;
 
+        void warning(const QString& warning) const;
+
         void progress() const;
     };
 }
@@ -168,4 +168,47 @@ namespace pboman3::io::test {
         int dataSize;
         bool expectedCompressed;
     };
+
+    TEST(PboBinarySource, WriteRangeToPbo_Writes_Data_Beyond_Entry) {
+        //create a binary source
+        QTemporaryFile sourceFile;
+        sourceFile.open();
+        for (char i = 0; i < 10; i++) {
+            sourceFile.write(&i, sizeof i);
+        }
+        sourceFile.close();
+
+        //call the service
+        constexpr PboDataInfo dataInfo{ 3, 3, 1, 0, false };
+        QTemporaryFile targetFile;
+        targetFile.open();
+        PboBinarySource bs(sourceFile.fileName(), dataInfo, 4);
+        bs.open();
+        bs.writeRangeToPbo(&targetFile, 8, []() { return false; });
+        targetFile.close();
+
+        //assert the file content
+        QFile f(targetFile.fileName());
+        f.open(QIODeviceBase::ReadOnly);
+        const QByteArray data = f.readAll();
+        f.close();
+
+        ASSERT_THAT(data, testing::ElementsAre(1, 2, 3, 4, 5, 6, 7, 8));
+    }
+
+    TEST(PboBinarySource, Precedes_Returns_True_For_Adjacent_Entries) {
+        constexpr PboDataInfo dataInfo1{ 3, 3, 1, 0, false };
+        constexpr PboDataInfo dataInfo2{ 5, 5, 4, 0, false };
+        constexpr PboDataInfo dataInfo3{ 2, 2, 10, 0, false };
+
+        const PboBinarySource bs1("file.pbo", dataInfo1);
+        const PboBinarySource bs2("file.pbo", dataInfo2);
+        const PboBinarySource bs3("file.pbo", dataInfo3);
+        const PboBinarySource bs4("other.pbo", dataInfo2);
+
+        ASSERT_TRUE(bs1.precedes(bs2));
+        ASSERT_FALSE(bs2.precedes(bs1));
+        ASSERT_FALSE(bs2.precedes(bs3));//a gap between the entries
+        ASSERT_FALSE(bs1.precedes(bs4));//another file
+    }
 }
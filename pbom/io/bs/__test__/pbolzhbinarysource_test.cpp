@@ -0,0 +1,71 @@
+#include "io/bs/pbolzhbinarysource.h"
+#include <QTemporaryFile>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace pboman3::io::test {
+    TEST(PboLzhBinarySourceTest, WriteToPbo_Compresses_Entry_Data) {
+        //create a binary source with the entry surrounded by other data
+        QTemporaryFile sourceFile;
+        sourceFile.open();
+        sourceFile.write(QByteArray("xxx"));
+        sourceFile.write(QByteArray("a             b"));
+        sourceFile.write(QByteArray("yyy"));
+        sourceFile.close();
+
+        //call the service
+        constexpr PboDataInfo dataInfo{0, 15, 3, 100, false};
+        QTemporaryFile targetFile;
+        targetFile.open();
+        PboLzhBinarySource bs(sourceFile.fileName(), dataInfo);
+        bs.open();
+        bs.writeToPbo(&targetFile, []() { return false; });
+        targetFile.close();
+
+        //assert the file content
+        QFile f(targetFile.fileName());
+        f.open(QIODeviceBase::ReadOnly);
+        const QByteArray data = f.readAll();
+        f.close();
+
+        ASSERT_THAT(data, testing::ElementsAre(0x05, 0x61, 0x0E, 0x0A, 0x62, 0x63, 0x02, 0x00, 0x00));
+    }
+
+    TEST(PboLzhBinarySourceTest, WriteToFs_Writes_Raw_Entry_Data) {
+        //create a binary source with the entry surrounded by other data
+        QTemporaryFile sourceFile;
+        sourceFile.open();
+        sourceFile.write(QByteArray("xxxentryyyy"));
+        sourceFile.close();
+
+        //call the service
+        constexpr PboDataInfo dataInfo{0, 5, 3, 100, false};
+        QTemporaryFile targetFile;
+        targetFile.open();
+        PboLzhBinarySource bs(sourceFile.fileName(), dataInfo);
+        bs.open();
+        bs.writeToFs(&targetFile, []() { return false; });
+        targetFile.close();
+
+        //assert the file content
+        QFile f(targetFile.fileName());
+        f.open(QIODeviceBase::ReadOnly);
+        const QByteArray data = f.readAll();
+        f.close();
+
+        ASSERT_EQ(data, QByteArray("entry"));
+    }
+
+    TEST(PboLzhBinarySourceTest, Reads_Sizes_And_Timestamp_From_Entry) {
+        QTemporaryFile sourceFile;
+        sourceFile.open();
+        sourceFile.close();
+
+        constexpr PboDataInfo dataInfo{0, 5, 3, 100, false};
+        const PboLzhBinarySource bs(sourceFile.fileName(), dataInfo);
+
+        ASSERT_EQ(bs.readOriginalSize(), 5);
+        ASSERT_EQ(bs.readTimestamp(), 100);
+        ASSERT_TRUE(bs.isCompressed());
+    }
+}
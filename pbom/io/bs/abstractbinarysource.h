@@ -11,7 +11,7 @@ namespace pboman3::io {
 
         virtual ~AbstractBinarySource();
 
-        void writeToPbo(QFileDevice* targetFile, const Cancel& cancel) override = 0;
+        void writeToPbo(QIODevice* target, const Cancel& cancel) override = 0;
 
         void writeToFs(QFileDevice* targetFile, const Cancel& cancel) override = 0;
 
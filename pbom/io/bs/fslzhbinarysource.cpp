@@ -6,11 +6,11 @@ namespace pboman3::io {
         : FsRawBinarySource(std::move(path), bufferSize){
     }
 
-    void FsLzhBinarySource::writeToPbo(QFileDevice* targetFile, const Cancel& cancel) {
+    void FsLzhBinarySource::writeToPbo(QIODevice* target, const Cancel& cancel) {
         assert(file_->isOpen());
         const bool seek = file_->seek(0);
         assert(seek);
-        Lzh::compress(file_, targetFile, cancel);
+        Lzh::compress(file_, target, cancel);
     }
 
     bool FsLzhBinarySource::isCompressed() const {
@@ -7,7 +7,7 @@ namespace pboman3::io {
     public:
         FsLzhBinarySource(QString path, qsizetype bufferSize = 1024 * 1024);
 
-        void writeToPbo(QFileDevice* targetFile, const Cancel& cancel) override;
+        void writeToPbo(QIODevice* target, const Cancel& cancel) override;
 
         bool isCompressed() const override;
     };
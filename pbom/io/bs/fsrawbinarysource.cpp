@@ -7,9 +7,9 @@ namespace pboman3::io {
           bufferSize_(bufferSize) {
     }
 
-    void FsRawBinarySource::writeToPbo(QFileDevice* targetFile, const Cancel& cancel) {
+    void FsRawBinarySource::writeToPbo(QIODevice* target, const Cancel& cancel) {
         assert(file_->isOpen());
-        writeRaw(targetFile, cancel);
+        writeRaw(target, cancel);
     }
 
     void FsRawBinarySource::writeToFs(QFileDevice* targetFile, const Cancel& cancel) {
@@ -17,7 +17,7 @@ namespace pboman3::io {
         writeRaw(targetFile, cancel);
     }
 
-    void FsRawBinarySource::writeRaw(QFileDevice* targetFile, const Cancel& cancel) const {
+    void FsRawBinarySource::writeRaw(QIODevice* target, const Cancel& cancel) const {
         const bool seek = file_->seek(0);
         assert(seek);
 
@@ -27,7 +27,7 @@ namespace pboman3::io {
         while (!cancel() && remaining > 0) {
             const qsizetype willRead = remaining > buf.size() ? buf.size() : remaining;
             const qint64 hasRead = file_->read(buf.data(), willRead);
-            targetFile->write(buf.data(), hasRead);
+            target->write(buf.data(), hasRead);
             remaining -= hasRead;
         }
     }
@@ -7,7 +7,7 @@ namespace pboman3::io {
     public:
         FsRawBinarySource(QString path, qsizetype bufferSize = 1024 * 1024);
 
-        void writeToPbo(QFileDevice* targetFile, const Cancel& cancel) override;
+        void writeToPbo(QIODevice* target, const Cancel& cancel) override;
 
         void writeToFs(QFileDevice* targetFile, const Cancel& cancel) override;
 
@@ -20,6 +20,6 @@ namespace pboman3::io {
     private:
         qsizetype bufferSize_;
 
-        void writeRaw(QFileDevice* targetFile, const Cancel& cancel) const;
+        void writeRaw(QIODevice* target, const Cancel& cancel) const;
     };
 }
@@ -2,6 +2,11 @@
 #include "io/diskaccessexception.h"
 #include "io/lzh/lzh.h"
 #include "io/lzh/lzhdecompressionexception.h"
+#include "util/tracer.h"
+
+#ifdef Q_OS_LINUX
+#include <fcntl.h>
+#endif
 
 namespace pboman3::io {
     PboBinarySource::PboBinarySource(const QString& path, const PboDataInfo& dataInfo, qsizetype bufferSize)
@@ -10,39 +15,61 @@ namespace pboman3::io {
           bufferSize_(bufferSize) {
     }
 
-    void PboBinarySource::writeToPbo(QFileDevice* targetFile, const Cancel& cancel) {
+    void PboBinarySource::writeToPbo(QIODevice* target, const Cancel& cancel) {
         assert(file_->isOpen());
-        writeRaw(targetFile, cancel);
+        writeRaw(target, dataInfo_.dataSize, cancel);
     }
 
     void PboBinarySource::writeToFs(QFileDevice* targetFile, const Cancel& cancel) {
         assert(file_->isOpen());
         if (isCompressed()) {
             if (!tryWriteDecompressed(targetFile, cancel))
-                writeRaw(targetFile, cancel);
+                writeRaw(targetFile, dataInfo_.dataSize, cancel);
+        } else {
+            writeRaw(targetFile, dataInfo_.dataSize, cancel);
+        }
+    }
+
+    void PboBinarySource::writeToStream(QIODevice* target, const Cancel& cancel) const {
+        assert(file_->isOpen());
+        if (isCompressed()) {
+            TRACE_SCOPE("unpack", "decompress")
+            const bool seek = file_->seek(dataInfo_.dataOffset);
+            assert(seek);
+            Lzh::decompress(file_, target, dataInfo_.originalSize, cancel);
         } else {
-            writeRaw(targetFile, cancel);
+            writeRaw(target, dataInfo_.dataSize, cancel);
         }
     }
 
-    void PboBinarySource::writeRaw(QFileDevice* targetFile, const Cancel& cancel) const {
+    void PboBinarySource::writeRangeToPbo(QIODevice* target, qint64 rangeSize, const Cancel& cancel) const {
+        assert(file_->isOpen());
+        writeRaw(target, rangeSize, cancel);
+    }
+
+    bool PboBinarySource::precedes(const PboBinarySource& next) const {
+        return dataInfo_.dataOffset + dataInfo_.dataSize == next.dataInfo_.dataOffset && path() == next.path();
+    }
+
+    void PboBinarySource::writeRaw(QIODevice* target, qint64 length, const Cancel& cancel) const {
         const bool seek = file_->seek(dataInfo_.dataOffset);
         assert(seek);
 
-        QByteArray buf(bufferSize_, Qt::Initialization::Uninitialized);
+        QByteArray buf(length < bufferSize_ ? length : bufferSize_, Qt::Initialization::Uninitialized);
 
-        qint64 remaining = dataInfo_.dataSize;
+        qint64 remaining = length;
         while (!cancel() && remaining > 0) {
             const qsizetype willRead = remaining > buf.size() ? buf.size() : remaining;
             const qint64 hasRead = file_->read(buf.data(), willRead);
             if (hasRead <= 0)
                 throw DiskAccessException("For some reason could not read from the file.", file_->fileName());
-            targetFile->write(buf.data(), hasRead);
+            target->write(buf.data(), hasRead);
             remaining -= hasRead;
         }
     }
 
     bool PboBinarySource::tryWriteDecompressed(QFileDevice* targetFile, const Cancel& cancel) const {
+        TRACE_SCOPE("unpack", "decompress")
         try {
             const bool seek = file_->seek(dataInfo_.dataOffset);
             assert(seek);
@@ -54,6 +81,16 @@ namespace pboman3::io {
         }
     }
 
+    void PboBinarySource::prefetch() const {
+#ifdef Q_OS_LINUX
+        const int handle = file_->handle();
+        if (handle == -1)
+            return;
+        posix_fadvise(handle, dataInfo_.dataOffset, dataInfo_.dataSize, POSIX_FADV_SEQUENTIAL);
+        posix_fadvise(handle, dataInfo_.dataOffset, dataInfo_.dataSize, POSIX_FADV_WILLNEED);
+#endif
+    }
+
     const PboDataInfo& PboBinarySource::getInfo() const {
         return dataInfo_;
     }
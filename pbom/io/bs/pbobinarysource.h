@@ -15,10 +15,23 @@ namespace pboman3::io {
     public:
         PboBinarySource(const QString& path, const PboDataInfo& dataInfo, qsizetype bufferSize = 1024 * 1024);
 
-        void writeToPbo(QFileDevice* targetFile, const Cancel& cancel) override;
+        void writeToPbo(QIODevice* target, const Cancel& cancel) override;
 
         void writeToFs(QFileDevice* targetFile, const Cancel& cancel) override;
 
+        //writes the decompressed entry contents strictly forward, so the target may be a pipe
+        //unlike writeToFs can not fall back to the raw bytes once the decompression fails, throws instead
+        void writeToStream(QIODevice* target, const Cancel& cancel) const;
+
+        //copies the raw bytes starting at the entry data offset, the range may span the subsequent entries
+        void writeRangeToPbo(QIODevice* target, qint64 rangeSize, const Cancel& cancel) const;
+
+        //whether the next entry data starts right where this entry data ends, in the same file
+        bool precedes(const PboBinarySource& next) const;
+
+        //hints the OS the entry data is going to be read soon and sequentially, no-op where unsupported
+        void prefetch() const;
+
         const PboDataInfo& getInfo() const;
 
         qint32 readOriginalSize() const override;
@@ -31,7 +44,7 @@ namespace pboman3::io {
         PboDataInfo dataInfo_;
         qsizetype bufferSize_;
 
-        void writeRaw(QFileDevice* targetFile, const Cancel& cancel) const;
+        void writeRaw(QIODevice* target, qint64 length, const Cancel& cancel) const;
 
         bool tryWriteDecompressed(QFileDevice* targetFile, const Cancel& cancel) const;
     };
@@ -0,0 +1,49 @@
+#include "pbolzhbinarysource.h"
+#include <QBuffer>
+#include "io/diskaccessexception.h"
+#include "io/lzh/lzh.h"
+
+namespace pboman3::io {
+    PboLzhBinarySource::PboLzhBinarySource(const QString& path, const PboDataInfo& dataInfo)
+        : FsLzhBinarySource(path),
+          dataInfo_(dataInfo) {
+        assert(!dataInfo.compressed && "The entry must be stored uncompressed");
+    }
+
+    void PboLzhBinarySource::writeToPbo(QIODevice* target, const Cancel& cancel) {
+        assert(file_->isOpen());
+        //the compression looks back and forth over the source, so the entry goes to memory rather than a temp file
+        QByteArray data = readData();
+        QBuffer source(&data);
+        source.open(QIODeviceBase::ReadOnly);
+        Lzh::compress(&source, target, cancel);
+    }
+
+    void PboLzhBinarySource::writeToFs(QFileDevice* targetFile, const Cancel& cancel) {
+        assert(file_->isOpen());
+        if (!cancel())
+            targetFile->write(readData());
+    }
+
+    QByteArray PboLzhBinarySource::readData() const {
+        const bool seek = file_->seek(dataInfo_.dataOffset);
+        assert(seek);
+        QByteArray data = file_->read(dataInfo_.dataSize);
+        if (data.size() != dataInfo_.dataSize)
+            throw DiskAccessException("For some reason could not read from the file.", file_->fileName());
+        return data;
+    }
+
+    const PboDataInfo& PboLzhBinarySource::getInfo() const {
+        return dataInfo_;
+    }
+
+    qint32 PboLzhBinarySource::readOriginalSize() const {
+        //the stored size, as some tools leave the original size 0 for the uncompressed entries
+        return dataInfo_.dataSize;
+    }
+
+    qint32 PboLzhBinarySource::readTimestamp() const {
+        return dataInfo_.timestamp;
+    }
+}
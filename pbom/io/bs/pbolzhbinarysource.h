@@ -0,0 +1,28 @@
+#pragma once
+
+#include "fslzhbinarysource.h"
+#include "pbobinarysource.h"
+
+namespace pboman3::io {
+    //an entry stored uncompressed in a PBO, compressed as it gets written to another PBO
+    //is an FsLzhBinarySource, so the writers compress it in parallel the same way they do the files from the disk
+    class PboLzhBinarySource : public FsLzhBinarySource {
+    public:
+        PboLzhBinarySource(const QString& path, const PboDataInfo& dataInfo);
+
+        void writeToPbo(QIODevice* target, const Cancel& cancel) override;
+
+        void writeToFs(QFileDevice* targetFile, const Cancel& cancel) override;
+
+        const PboDataInfo& getInfo() const;
+
+        qint32 readOriginalSize() const override;
+
+        qint32 readTimestamp() const override;
+
+    private:
+        PboDataInfo dataInfo_;
+
+        QByteArray readData() const;
+    };
+}
@@ -0,0 +1,106 @@
+#include "compressionpipeline.h"
+#include <QBuffer>
+#include "util/executionpools.h"
+#include "util/log.h"
+#include "util/tracer.h"
+
+#define LOG(...) LOGGER("io/CompressionPipeline", __VA_ARGS__)
+
+namespace pboman3::io {
+    CompressionPipeline::CompressionPipeline(const QList<PboNode*>& nodes, qsizetype depth, qint64 maxBytes,
+                                             const Cancel& cancel, TaskStats* stats)
+        : depth_(depth),
+          maxBytes_(maxBytes),
+          bytesInFlight_(0),
+          cancel_(cancel),
+          stats_(stats),
+          submitted_(0),
+          taken_(0),
+          running_(0),
+          stopped_(0) {
+        assert(depth > 0);
+
+        slots_.reserve(nodes.count());
+        for (PboNode* node : nodes)
+            slots_.append(Slot{node, node->binarySource->readOriginalSize(), nullptr, nullptr, false});
+
+        LOG(info, "Compress", slots_.count(), "nodes with the depth of", depth_, "and the budget of", maxBytes_, "bytes")
+
+        QMutexLocker locker(&mutex_);
+        submit();
+    }
+
+    CompressionPipeline::~CompressionPipeline() {
+        QMutexLocker locker(&mutex_);
+        stopped_.storeRelease(1);
+        while (running_ > 0)
+            slotDone_.wait(&mutex_);
+    }
+
+    QSharedPointer<QByteArray> CompressionPipeline::take(const PboNode* node) {
+        QMutexLocker locker(&mutex_);
+
+        assert(taken_ < slots_.count() && slots_.at(taken_).node == node);
+
+        Slot& slot = slots_[taken_];
+        while (!slot.done)
+            slotDone_.wait(&mutex_);
+
+        taken_++;
+        bytesInFlight_ -= slot.size;
+        submit();
+
+        if (slot.error)
+            std::rethrow_exception(slot.error);
+
+        QSharedPointer<QByteArray> data = std::move(slot.data);
+        return data;
+    }
+
+    void CompressionPipeline::submit() {
+        //the caller holds the mutex
+        while (submitted_ < slots_.count() && submitted_ - taken_ < depth_ && !stopped_.loadAcquire()) {
+            //the compressed data hardly outgrow the source, so the source sizes bound the memory held
+            //a node over the budget still goes when nothing else is held, otherwise the pipeline would stall
+            const qint64 size = slots_.at(submitted_).size;
+            if (submitted_ > taken_ && bytesInFlight_ + size > maxBytes_)
+                break;
+            const qsizetype index = submitted_++;
+            bytesInFlight_ += size;
+            running_++;
+            util::ExecutionPools::compute()->start([this, index]() { compress(index); });
+        }
+    }
+
+    void CompressionPipeline::compress(qsizetype index) {
+        QSharedPointer<QByteArray> data;
+        std::exception_ptr error;
+
+        const Cancel cancel = [this]() {
+            return stopped_.loadAcquire() || cancel_();
+        };
+
+        try {
+            if (!cancel()) {
+                TRACE_SCOPE("pack", "compress", slots_.at(index).node->title())
+                ScopedPhase phase(stats_, "compress");
+                data = QSharedPointer<QByteArray>::create();
+                QBuffer buffer(data.get());
+                buffer.open(QIODeviceBase::WriteOnly);
+                BinarySource* source = slots_.at(index).node->binarySource.get();
+                source->writeToPbo(&buffer, cancel);
+                phase.addBytes(source->readOriginalSize(), data->size());
+            }
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        QMutexLocker locker(&mutex_);
+        Slot& slot = slots_[index];
+        slot.data = std::move(data);
+        slot.error = error;
+        slot.done = true;
+        running_--;
+        slotDone_.wakeAll();
+    }
+}
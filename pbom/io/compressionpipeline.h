@@ -0,0 +1,56 @@
+#pragma once
+
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QMutex>
+#include <QWaitCondition>
+#include <exception>
+#include "domain/pbonode.h"
+#include "util/taskstats.h"
+#include "util/util.h"
+
+namespace pboman3::io {
+    using namespace domain;
+
+    //compresses the nodes on the compute pool ahead of the thread writing them
+    //at most `depth` nodes are in flight or waiting to be taken, so a slow writer holds the compression back
+    //and the compressed bytes can be kept in memory instead of the temporary files
+    //the source sizes of those nodes add up to `maxBytes` at most, a larger node is compressed alone
+    class CompressionPipeline {
+    public:
+        CompressionPipeline(const QList<PboNode*>& nodes, qsizetype depth, qint64 maxBytes, const Cancel& cancel,
+                            TaskStats* stats = nullptr);
+
+        ~CompressionPipeline();
+
+        //blocks until the node is compressed, the nodes must be taken in the order they were given
+        //returns nullptr if the compression was cancelled
+        QSharedPointer<QByteArray> take(const PboNode* node);
+
+    private:
+        struct Slot {
+            PboNode* node;
+            qint64 size;
+            QSharedPointer<QByteArray> data;
+            std::exception_ptr error;
+            bool done;
+        };
+
+        QList<Slot> slots_;
+        qsizetype depth_;
+        qint64 maxBytes_;
+        qint64 bytesInFlight_;
+        const Cancel& cancel_;
+        TaskStats* stats_;
+        qsizetype submitted_;
+        qsizetype taken_;
+        int running_;
+        QAtomicInt stopped_;
+        QMutex mutex_;
+        QWaitCondition slotDone_;
+
+        void submit();
+
+        void compress(qsizetype index);
+    };
+}
@@ -3,6 +3,7 @@
 #include "diskaccessexception.h"
 #include "pboheaderreader.h"
 #include "bs/pbobinarysource.h"
+#include "util/tracer.h"
 
 namespace pboman3::io {
     DocumentReader::DocumentReader(QString path)
@@ -10,6 +11,11 @@ namespace pboman3::io {
     }
 
     QSharedPointer<PboDocument> DocumentReader::read() const {
+        return read(PboEntryFilter());
+    }
+
+    QSharedPointer<PboDocument> DocumentReader::read(const PboEntryFilter& filter) const {
+        TRACE_SCOPE("unpack", "read header", path_)
         PboFile pbo(path_);
         if (!pbo.open(QIODeviceBase::ReadOnly)) {
             throw DiskAccessException("Can not access the file. Check if it is used by other processes.", path_);
@@ -26,7 +32,12 @@ namespace pboman3::io {
 
         qsizetype entryDataOffset = header.dataBlockStart;
         for (const QSharedPointer<PboNodeEntity>& e : header.entries) {
-            PboNode* node = document->root()->createHierarchy(e->makePath());
+            const PboPath path = e->makePath();
+            if (!filter.matches(path)) {
+                entryDataOffset += e->dataSize();
+                continue;
+            }
+            PboNode* node = document->root()->createHierarchy(path);
             PboDataInfo dataInfo{0, 0, 0, 0, 0};
             dataInfo.originalSize = e->originalSize();
             dataInfo.dataSize = e->dataSize();
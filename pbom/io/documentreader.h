@@ -1,6 +1,7 @@
 #pragma once
 
 #include "domain/pbodocument.h"
+#include "pboentryfilter.h"
 
 namespace pboman3::io {
     using namespace domain;
@@ -11,6 +12,9 @@ namespace pboman3::io {
 
         QSharedPointer<PboDocument> read() const;
 
+        //builds the tree of just the entries the filter selects, the data of the rest is never touched
+        QSharedPointer<PboDocument> read(const PboEntryFilter& filter) const;
+
     private:
         QString path_;
     };
@@ -4,16 +4,24 @@
 #include "diskaccessexception.h"
 #include "pboheaderentity.h"
 #include "pboheaderio.h"
+#include "bs/fslzhbinarysource.h"
+#include "util/executionpools.h"
 #include "util/log.h"
+#include "util/tracer.h"
 
 #define LOG(...) LOGGER("io/documentwriter", __VA_ARGS__)
 
 namespace pboman3::io {
     DocumentWriter::DocumentWriter(QString path)
-        : path_(std::move(path)) {
+        : path_(std::move(path)),
+          stats_(nullptr) {
         assert(!path_.isEmpty() && "Path must not be empty");
     }
 
+    void DocumentWriter::setStats(TaskStats* stats) {
+        stats_ = stats;
+    }
+
     void DocumentWriter::write(PboDocument* document, const Cancel& cancel) {
         assert(document && "Document must not be null");
 
@@ -96,7 +104,15 @@ namespace pboman3::io {
 
         LOG(info, "Writing nodes")
         QList<QSharedPointer<PboNodeEntity>> entries;
-        writeNode(&body, document->root(), entries, cancel);
+        qint64 inputBytes = 0;
+        {
+            TRACE_SCOPE("pack", "write entries")
+            ScopedPhase phase(stats_, "write entries");
+            writeNode(&body, document->root(), entries, cancel);
+            for (const QSharedPointer<PboNodeEntity>& entry : entries)
+                inputBytes += entry->originalSize() ? entry->originalSize() : entry->dataSize();
+            phase.addBytes(inputBytes, body.size());
+        }
 
         if (cancel()) {
             LOG(info, "Cancel - return")
@@ -110,7 +126,12 @@ namespace pboman3::io {
         }
 
         LOG(info, "Writing headers")
-        writeHeader(&pbo, document->headers(), entries, cancel);
+        {
+            TRACE_SCOPE("pack", "write header")
+            ScopedPhase phase(stats_, "write header");
+            writeHeader(&pbo, document->headers(), entries, cancel);
+            phase.addBytes(0, pbo.pos());
+        }
 
         if (cancel()) {
             LOG(info, "Cancel - clean temp files and return")
@@ -123,10 +144,23 @@ namespace pboman3::io {
         assert(seek);
 
         LOG(info, "Copy body bytes")
-        copyBody(&pbo, &body, cancel);
+        {
+            TRACE_SCOPE("pack", "copy body")
+            ScopedPhase phase(stats_, "copy body");
+            copyBody(&pbo, &body, cancel);
+            phase.addBytes(body.size(), body.size());
+        }
 
         LOG(info, "Calc signature")
-        writeSignature(&pbo, document, cancel);
+        {
+            TRACE_SCOPE("pack", "write signature")
+            ScopedPhase phase(stats_, "write signature");
+            phase.addBytes(pbo.size(), 0);
+            writeSignature(&pbo, document, cancel);
+        }
+
+        if (stats_)
+            stats_->setBytes(inputBytes, pbo.size());
 
         if (cancel()) {
             LOG(info, "Cancel - clean temp files")
@@ -137,43 +171,130 @@ namespace pboman3::io {
 
     void DocumentWriter::writeNode(QFileDevice* file, PboNode* node, QList<QSharedPointer<PboNodeEntity>>& entries,
                                    const Cancel& cancel) {
-        for (PboNode* child : *node) {
+        QList<PboNode*> nodes;
+        collectFileNodes(node, nodes);
+
+        //the compression is CPU-bound, so it runs on the compute pool while this thread writes the results in order
+        QList<PboNode*> compressible;
+        for (PboNode* n : nodes) {
+            if (dynamic_cast<FsLzhBinarySource*>(n->binarySource.get()))
+                compressible.append(n);
+        }
+
+        if (compressible.count() > 1) {
+            CompressionPipeline compression(compressible, 2 * ExecutionPools::compute()->maxThreadCount(),
+                                            maxCompressionBytes, cancel, stats_);
+            writeNodes(file, nodes, &compression, entries, cancel);
+        } else {
+            writeNodes(file, nodes, nullptr, entries, cancel);
+        }
+    }
+
+    void DocumentWriter::writeNodes(QFileDevice* file, const QList<PboNode*>& nodes, CompressionPipeline* compression,
+                                    QList<QSharedPointer<PboNodeEntity>>& entries, const Cancel& cancel) {
+        qsizetype index = 0;
+        while (index < nodes.count()) {
             if (cancel()) {
                 LOG(info, "Cancel - return")
                 return;
             }
 
-            if (child->nodeType() == PboNodeType::File) {
-                const qint64 before = file->pos();
-                child->binarySource->writeToPbo(file, cancel);
-                const qint64 after = file->pos();
+            const qint64 before = file->pos();
+
+            //the entries of a PBO the document was read from are mostly adjacent byte ranges of the same file,
+            //so a run of them can be moved with a single seek and a single read loop
+            qint64 rangeSize = 0;
+            const qsizetype rangeCount = countContiguousNodes(nodes, index, &rangeSize);
+            if (rangeCount > 1) {
+                LOG(debug, "Copy", rangeCount, "contiguous entries of", rangeSize, "bytes")
+                TRACE_SCOPE("pack", "copy range")
+                const auto head = dynamic_cast<PboBinarySource*>(nodes.at(index)->binarySource.get());
+                head->writeRangeToPbo(file, rangeSize, cancel);
+                if (cancel()) {
+                    LOG(info, "Cancel - return")
+                    return;
+                }
 
-                const qint32 originalSize = child->binarySource->readOriginalSize();
-                const auto dataSize = static_cast<qint32>(after - before);
+                qint64 offset = before;
+                for (qsizetype i = index; i < index + rangeCount; i++) {
+                    PboNode* node = nodes.at(i);
+                    const qint32 dataSize = dynamic_cast<PboBinarySource*>(node->binarySource.get())->getInfo().dataSize;
+                    registerEntry(node, offset, dataSize, entries);
+                    offset += dataSize;
+                }
+                index += rangeCount;
+            } else {
+                PboNode* node = nodes.at(index);
+                TRACE_SCOPE("pack", "write", node->title())
+                if (compression && dynamic_cast<FsLzhBinarySource*>(node->binarySource.get())) {
+                    const QSharedPointer<QByteArray> compressed = compression->take(node);
+                    if (compressed)
+                        file->write(*compressed);
+                } else {
+                    node->binarySource->writeToPbo(file, cancel);
+                }
+                const qint64 after = file->pos();
+                registerEntry(node, before, static_cast<qint32>(after - before), entries);
+                index++;
+            }
+        }
+    }
 
-                QSharedPointer<PboNodeEntity> entry(new PboNodeEntity(
-                    child->makePath().toString(),
-                    child->binarySource->isCompressed() ? PboPackingMethod::Packed : PboPackingMethod::Uncompressed,
-                    child->binarySource->readOriginalSize(),
-                    0,
-                    child->binarySource->readTimestamp(),
-                    dataSize));
-                entries.append(entry);
+    void DocumentWriter::collectFileNodes(PboNode* node, QList<PboNode*>& result) const {
+        for (PboNode* child : *node) {
+            if (child->nodeType() == PboNodeType::File) {
+                result.append(child);
+            } else {
+                collectFileNodes(child, result);
+            }
+        }
+    }
 
-                PboDataInfo data{0, 0, 0, 0, 0};
-                data.originalSize = originalSize;
-                data.dataSize = dataSize;
-                data.dataOffset = before;
-                data.timestamp = child->binarySource->readTimestamp();
-                data.compressed = child->binarySource->isCompressed();
+    qsizetype DocumentWriter::countContiguousNodes(const QList<PboNode*>& nodes, qsizetype from, qint64* rangeSize) {
+        const auto* prev = dynamic_cast<PboBinarySource*>(nodes.at(from)->binarySource.get());
+        if (!prev)
+            return 1;
 
-                binarySources_.insert(child, data);
+        *rangeSize = prev->getInfo().dataSize;
 
-                emitWriteEntry();
-            } else {
-                writeNode(file, child, entries, cancel);
-            }
+        qsizetype count = 1;
+        while (from + count < nodes.count()) {
+            const auto* next = dynamic_cast<PboBinarySource*>(nodes.at(from + count)->binarySource.get());
+            if (!next || !prev->precedes(*next))
+                break;
+            *rangeSize += next->getInfo().dataSize;
+            prev = next;
+            count++;
         }
+
+        return count;
+    }
+
+    void DocumentWriter::registerEntry(PboNode* node, qint64 dataOffset, qint32 dataSize,
+                                       QList<QSharedPointer<PboNodeEntity>>& entries) {
+        const qint32 originalSize = node->binarySource->readOriginalSize();
+        const qint32 timestamp = node->binarySource->readTimestamp();
+        const bool compressed = node->binarySource->isCompressed();
+
+        QSharedPointer<PboNodeEntity> entry(new PboNodeEntity(
+            node->makePath().toString(),
+            compressed ? PboPackingMethod::Packed : PboPackingMethod::Uncompressed,
+            originalSize,
+            0,
+            timestamp,
+            dataSize));
+        entries.append(entry);
+
+        PboDataInfo data{0, 0, 0, 0, 0};
+        data.originalSize = originalSize;
+        data.dataSize = dataSize;
+        data.dataOffset = dataOffset;
+        data.timestamp = timestamp;
+        data.compressed = compressed;
+
+        binarySources_.insert(node, data);
+
+        emitWriteEntry();
     }
 
     void DocumentWriter::writeHeader(PboFile* file, const DocumentHeaders* headers,
@@ -4,8 +4,10 @@
 #include <QString>
 #include "pbonodeentity.h"
 #include "pbofile.h"
+#include "compressionpipeline.h"
 #include "bs/pbobinarysource.h"
 #include "domain/pbodocument.h"
+#include "util/taskstats.h"
 #include "util/util.h"
 
 namespace pboman3::io {
@@ -19,19 +21,33 @@ namespace pboman3::io {
 
         void write(PboDocument* document, const Cancel& cancel);
 
+        void setStats(TaskStats* stats);
+
         struct ProgressEvent;
 
     signals:
         void progress(const ProgressEvent* evt);
 
     private:
+        //the source bytes being compressed ahead of the writer at once, so large textures do not pile up in memory
+        static constexpr qint64 maxCompressionBytes = 128 * 1024 * 1024;
+
         QString path_;
         QHash<PboNode*, PboDataInfo> binarySources_;
+        TaskStats* stats_;
 
         void writeInternal(PboDocument* document, const QString& path, const Cancel& cancel);
 
         void writeNode(QFileDevice* file, PboNode* node, QList<QSharedPointer<PboNodeEntity>>& entries, const Cancel& cancel);
 
+        void writeNodes(QFileDevice* file, const QList<PboNode*>& nodes, CompressionPipeline* compression, QList<QSharedPointer<PboNodeEntity>>& entries, const Cancel& cancel);
+
+        void collectFileNodes(PboNode* node, QList<PboNode*>& result) const;
+
+        static qsizetype countContiguousNodes(const QList<PboNode*>& nodes, qsizetype from, qint64* rangeSize);
+
+        void registerEntry(PboNode* node, qint64 dataOffset, qint32 dataSize, QList<QSharedPointer<PboNodeEntity>>& entries);
+
         void writeHeader(PboFile* file, const DocumentHeaders* headers, const QList<QSharedPointer<PboNodeEntity>>& entries, const Cancel& cancel);
 
         void copyBody(QFileDevice* pbo, QFileDevice* body, const Cancel& cancel);
@@ -1,4 +1,5 @@
 #include "io/lzh/lzh.h"
+#include <QBuffer>
 #include <QTemporaryFile>
 #include <gtest/gtest.h>
 
@@ -58,6 +59,24 @@ namespace pboman3::io::test {
         ASSERT_EQ(targetBytes.length(), 32);
     }
 
+    TEST(LzhTest, Decompress_Treats_Pointers_Before_Entry_As_Whitespace_If_Target_Not_At_Start) {
+        //a pointer 1 byte back at the entry start, then the "a" and "b" literals, then the checksum
+        const quint32 crc = 3 * 0x20 + 'a' + 'b';
+        QByteArray compressed("\xFE\x01\x00" "ab", 5);
+        compressed.append(reinterpret_cast<const char*>(&crc), sizeof crc);
+        QBuffer source(&compressed);
+        source.open(QIODeviceBase::ReadOnly);
+
+        QByteArray output("existing");
+        QBuffer target(&output);
+        target.open(QIODeviceBase::ReadWrite);
+        target.seek(output.size());
+
+        Lzh::decompress(&source, &target, 5, []() { return false; });
+
+        ASSERT_EQ(output, QByteArray("existing   ab"));
+    }
+
     class CompressTest : public testing::TestWithParam<LzhTestParam> {
     };
 
@@ -9,7 +9,7 @@ namespace pboman3::io {
         dataPtr_ = data_.data();
     }
 
-    void CompressionBuffer::add(QFileDevice* source, qint64 length) {
+    void CompressionBuffer::add(QIODevice* source, qint64 length) {
         if (fullfillment_ + length > size_) {
             //shift the buffer contents left until there is enough space for the new bunch of bytes
             const qint64 bytesToMoveCount = size_ - length;
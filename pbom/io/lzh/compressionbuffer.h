@@ -1,6 +1,6 @@
 #pragma once
 
-#include <QFileDevice>
+#include <QIODevice>
 
 namespace pboman3::io {
     struct BufferIntersection {
@@ -20,7 +20,7 @@ namespace pboman3::io {
 
         CompressionBuffer(qint64 size = defaultSize);
 
-        void add(QFileDevice* source, qint64 length);
+        void add(QIODevice* source, qint64 length);
 
         void add(char byte);
 
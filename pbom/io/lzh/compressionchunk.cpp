@@ -8,7 +8,7 @@ namespace pboman3::io {
         next_.resize(maxChunkSize_);
     }
 
-    qint64 CompressionChunk::compose(QFileDevice* source, CompressionBuffer& dict) {
+    qint64 CompressionChunk::compose(QIODevice* source, CompressionBuffer& dict) {
         qint64 packedTotal = 0;
 
         for (qint8 i = 0; i < chunks_ && !source->atEnd(); i++) {
@@ -27,13 +27,13 @@ namespace pboman3::io {
         return packedTotal;
     }
 
-    int CompressionChunk::flush(QFileDevice* target) {
+    int CompressionChunk::flush(QIODevice* target) {
         target->write(reinterpret_cast<const char*>(&format_), sizeof format_);
         target->write(data_.data(), length_);
         return length_ + 1;
     }
 
-    qint64 CompressionChunk::composeUncompressed(qint8 chunk, QFileDevice* source, CompressionBuffer& dict) {
+    qint64 CompressionChunk::composeUncompressed(qint8 chunk, QIODevice* source, CompressionBuffer& dict) {
         constexpr qint64 bytesToCopy = 1;
         char byte;
         source->peek(&byte, bytesToCopy);
@@ -46,7 +46,7 @@ namespace pboman3::io {
         return bytesToCopy;
     }
 
-    qint64 CompressionChunk::composeCompressed(qint8 chunk, QFileDevice* source, qint64 chunkSize,
+    qint64 CompressionChunk::composeCompressed(qint8 chunk, QIODevice* source, qint64 chunkSize,
                                                CompressionBuffer& dict) {
         source->peek(next_.data(), chunkSize);
 
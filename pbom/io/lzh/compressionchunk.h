@@ -7,9 +7,9 @@ namespace pboman3::io {
     public:
         CompressionChunk();
 
-        qint64 compose(QFileDevice* source, CompressionBuffer& dict);
+        qint64 compose(QIODevice* source, CompressionBuffer& dict);
 
-        int flush(QFileDevice* target);
+        int flush(QIODevice* target);
     private:
         inline static qint8 chunks_ = 8;
         inline static qint64 minBytesToPack_ = 3;
@@ -21,9 +21,9 @@ namespace pboman3::io {
         qint8 format_;
         int length_;
 
-        qint64 composeUncompressed(qint8 chunk, QFileDevice* source, CompressionBuffer& dict);
+        qint64 composeUncompressed(qint8 chunk, QIODevice* source, CompressionBuffer& dict);
 
-        qint64 composeCompressed(qint8 chunk, QFileDevice* source, qint64 chunkSize, CompressionBuffer& dict);
+        qint64 composeCompressed(qint8 chunk, QIODevice* source, qint64 chunkSize, CompressionBuffer& dict);
 
         qint16 composePointer(qint64 offset, qint64 length);
     };
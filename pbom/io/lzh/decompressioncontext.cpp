@@ -1,30 +1,52 @@
 #include "decompressioncontext.h"
+#include <algorithm>
+#include <cstring>
 
 namespace pboman3::io {
-    DecompressionContext::DecompressionContext(QFileDevice* pSource, QFileDevice* pTarget)
+    DecompressionContext::DecompressionContext(QIODevice* pSource, QIODevice* pTarget, qint64 outputLength)
         : format(0),
         crc(0),
         source(pSource),
-        target(pTarget) {
+        target(pTarget),
+        outputBase_(0) {
         buffer.resize(18);
+        //the files smaller than a chunk are decoded entirely in memory and written at once
+        output_.reserve(std::min(outputLength, static_cast<qint64>(chunkSize_ + windowSize_)) + buffer.size());
     }
 
     void DecompressionContext::write(char data) {
-        target->write(&data, sizeof data);
+        output_.append(data);
         updateCrc(data);
+        if (output_.size() >= chunkSize_ + windowSize_)
+            writeChunk();
     }
 
     void DecompressionContext::write(const QByteArray& data, int chunkSize) {
-        target->write(data.data(), chunkSize);
+        output_.append(data.data(), chunkSize);
         updateCrc(data, chunkSize);
+        if (output_.size() >= chunkSize_ + windowSize_)
+            writeChunk();
     }
 
     void DecompressionContext::setBuffer(qint64 offset, int length) {
-        const qint64 pos = target->pos();
-        const bool seek = target->seek(offset);
-        assert(seek);
-        target->read(buffer.data(), length);
-        target->seek(pos);
+        assert(offset >= outputBase_ && offset + length <= pos());
+        memcpy(buffer.data(), output_.data() + (offset - outputBase_), length);
+    }
+
+    qint64 DecompressionContext::pos() const {
+        return outputBase_ + output_.size();
+    }
+
+    void DecompressionContext::flush() {
+        target->write(output_.data(), output_.size());
+        outputBase_ += output_.size();
+        output_.resize(0);
+    }
+
+    void DecompressionContext::writeChunk() {
+        target->write(output_.data(), chunkSize_);
+        output_.remove(0, chunkSize_);
+        outputBase_ += chunkSize_;
     }
 
     void DecompressionContext::updateCrc(char data) {
@@ -8,10 +8,10 @@ namespace pboman3::io {
         int format;
         uint crc;
         QByteArray buffer;
-        QFileDevice* source;
-        QFileDevice* target;
+        QIODevice* source;
+        QIODevice* target;
 
-        DecompressionContext(QFileDevice* pSource, QFileDevice* pTarget);
+        DecompressionContext(QIODevice* pSource, QIODevice* pTarget, qint64 outputLength);
 
         void write(char data);
 
@@ -19,7 +19,22 @@ namespace pboman3::io {
 
         void setBuffer(qint64 offset, int length);
 
+        //the position in the output of this entry, including the bytes not yet flushed to the target
+        //counts from 0 whatever the position of the target is, so the pointers before the entry start stay negative
+        qint64 pos() const;
+
+        void flush();
+
     private:
+        //LZH pointers reach at most 4095 bytes back, so this much output stays in memory after a chunk is flushed
+        static constexpr qsizetype windowSize_ = 4096;
+        static constexpr qsizetype chunkSize_ = 64 * 1024;
+
+        QByteArray output_;
+        qint64 outputBase_;
+
+        void writeChunk();
+
         void updateCrc(char data);
 
         void updateCrc(const QByteArray& data, int chunkSize);
@@ -6,18 +6,19 @@
 #define LOG(...) LOGGER("io/lzh/Lzh", __VA_ARGS__)
 
 namespace pboman3::io {
-    void Lzh::decompress(QFileDevice* source, QFileDevice* target, int outputLength, const Cancel& cancel) {
-        DecompressionContext ctx(source, target);
-        const qint64 maxTargetOffset = target->pos() + outputLength;
+    void Lzh::decompress(QIODevice* source, QIODevice* target, int outputLength, const Cancel& cancel) {
+        DecompressionContext ctx(source, target, outputLength);
+        const qint64 maxTargetOffset = outputLength;
         const qint64 maxSourceOffset = source->size() - 2;
-        while (target->pos() < maxTargetOffset && !source->atEnd() && !cancel()) {
+        while (ctx.pos() < maxTargetOffset && !source->atEnd() && !cancel()) {
             char format;
             source->read(&format, sizeof format);
-            for (char i = 0; i < 8 && target->pos() < maxTargetOffset && source->pos() < maxSourceOffset; i++) {
+            for (char i = 0; i < 8 && ctx.pos() < maxTargetOffset && source->pos() < maxSourceOffset; i++) {
                 ctx.format = format >> i & 0x01;
                 processBlock(ctx);
             }
         }
+        ctx.flush();
         if (!cancel()) {
             //does not make sense to check validity if cancel
             //as it won't be valid
@@ -29,7 +30,7 @@ namespace pboman3::io {
         }
     }
 
-    void Lzh::compress(QFileDevice* source, QFileDevice* target, const Cancel& cancel) {
+    void Lzh::compress(QIODevice* source, QIODevice* target, const Cancel& cancel) {
         assert(source->pos() == 0 && "File offset must be 0 for LZH compression");
 
         CompressionBuffer dict(CompressionBuffer::defaultSize);
@@ -55,7 +56,7 @@ namespace pboman3::io {
         } else {
             qint16 pointer;
             ctx.source->read(reinterpret_cast<char*>(&pointer), sizeof pointer);
-            qint64 rpos = ctx.target->pos() - static_cast<qint64>((pointer & 0x00ff))
+            qint64 rpos = ctx.pos() - static_cast<qint64>((pointer & 0x00ff))
                 - static_cast<qint64>(((pointer & 0xf000) >> 4));
             int rlen = ((pointer & 0x0f00) >> 8) + 3;
 
@@ -69,8 +70,8 @@ namespace pboman3::io {
                     rlen--;
                 }
                 if (rlen > 0) {
-                    const int chunkSize = rpos + rlen > ctx.target->pos()
-                                              ? static_cast<int>(ctx.target->pos() - rpos)
+                    const int chunkSize = rpos + rlen > ctx.pos()
+                                              ? static_cast<int>(ctx.pos() - rpos)
                                               : rlen;
                     ctx.setBuffer(rpos, chunkSize);
 
@@ -98,7 +99,7 @@ namespace pboman3::io {
         return valid;
     }
 
-    void Lzh::writeCrc(QFileDevice* source, QFileDevice* target) {
+    void Lzh::writeCrc(QIODevice* source, QIODevice* target) {
         QByteArray buffer(1024, Qt::Initialization::Uninitialized);
         quint32 crc = 0;
 
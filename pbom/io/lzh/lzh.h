@@ -8,16 +8,16 @@ namespace pboman3::io {
 
     class Lzh {
     public:
-        static void decompress(QFileDevice* source, QFileDevice* target, int outputLength, const Cancel& cancel);
+        static void decompress(QIODevice* source, QIODevice* target, int outputLength, const Cancel& cancel);
 
-        static void compress(QFileDevice* source, QFileDevice* target, const Cancel& cancel);
+        static void compress(QIODevice* source, QIODevice* target, const Cancel& cancel);
 
     private:
         static void processBlock(DecompressionContext& ctx);
 
         static bool isValid(const DecompressionContext& ctx);
 
-        static void writeCrc(QFileDevice* source, QFileDevice* target);
+        static void writeCrc(QIODevice* source, QIODevice* target);
 
     };
 }
@@ -1,20 +1,20 @@
 #include "pbodatastream.h"
 
 namespace pboman3::io {
-    PboDataStream::PboDataStream(PboFile* file)
-        : QDataStream(file),
-          file_(file) {
+    PboDataStream::PboDataStream(QIODevice* device)
+        : QDataStream(device),
+          device_(device) {
     }
 
     PboDataStream& PboDataStream::operator>>(QString& out) {
-        if (!file_->readCString(out)) {
+        if (!PboFile::readCString(device_, out)) {
             throw PboEofException();
         }
         return *this;
     }
 
     PboDataStream& PboDataStream::operator<<(const QString& src) {
-        file_->writeCString(src);
+        PboFile::writeCString(device_, src);
         return *this;
     }
 
@@ -9,7 +9,7 @@ namespace pboman3::io {
 
     class PboDataStream : public QDataStream {
     public:
-        explicit PboDataStream(PboFile* file);
+        explicit PboDataStream(QIODevice* device);
 
         PboDataStream& operator>>(QString& out);
 
@@ -17,7 +17,7 @@ namespace pboman3::io {
 
         template <typename T>
         PboDataStream& operator>>(T& out) {
-            if (file_->read(reinterpret_cast<char*>(&out), sizeof out) != sizeof out) {
+            if (device_->read(reinterpret_cast<char*>(&out), sizeof out) != sizeof out) {
                 throw PboEofException();
             }
             return *this;
@@ -25,11 +25,11 @@ namespace pboman3::io {
 
         template <typename T>
         PboDataStream& operator<<(const T& src) {
-            file_->write(reinterpret_cast<const char*>(&src), sizeof src);
+            device_->write(reinterpret_cast<const char*>(&src), sizeof src);
             return *this;
         }
 
     private:
-        PboFile* file_;
+        QIODevice* device_;
     };
 }
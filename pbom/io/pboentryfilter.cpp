@@ -0,0 +1,98 @@
+#include "pboentryfilter.h"
+#include <QFile>
+
+namespace pboman3::io {
+    void PboEntryFilter::addInclude(const QString& glob) {
+        includes_.append(makeGlob(glob));
+    }
+
+    void PboEntryFilter::addExclude(const QString& glob) {
+        excludes_.append(makeGlob(glob));
+    }
+
+    void PboEntryFilter::addPath(const QString& path) {
+        paths_.insert(normalize(path));
+    }
+
+    bool PboEntryFilter::addPathsFrom(const QString& file) {
+        QFile f(file);
+        if (!f.open(QIODeviceBase::ReadOnly | QIODeviceBase::Text))
+            return false;
+        bool added = false;
+        while (!f.atEnd()) {
+            const QString line = QString::fromUtf8(f.readLine()).trimmed();
+            if (!line.isEmpty()) {
+                addPath(line);
+                added = true;
+            }
+        }
+        return added;
+    }
+
+    bool PboEntryFilter::isEmpty() const {
+        return includes_.isEmpty() && excludes_.isEmpty() && paths_.isEmpty();
+    }
+
+    bool PboEntryFilter::matches(const PboPath& path) const {
+        if (isEmpty())
+            return true;
+
+        const QString full = path.join('/').toLower();
+        const QString fileName = path.isEmpty() ? QString() : path.last().toLower();
+
+        const bool selected = (includes_.isEmpty() && paths_.isEmpty())
+            || paths_.contains(full)
+            || matchesAny(includes_, full, fileName);
+
+        return selected && !matchesAny(excludes_, full, fileName);
+    }
+
+    PboEntryFilter::Glob PboEntryFilter::makeGlob(const QString& glob) {
+        const QString norm = normalize(glob);
+
+        QString pattern;
+        pattern.reserve(norm.length() * 2);
+        for (qsizetype i = 0; i < norm.length(); i++) {
+            const QChar c = norm.at(i);
+            if (c == '*') {
+                if (i + 1 < norm.length() && norm.at(i + 1) == '*') {
+                    i++;
+                    //"**/" also matches no directories at all
+                    if (i + 1 < norm.length() && norm.at(i + 1) == '/') {
+                        i++;
+                        pattern.append("(?:.*/)?");
+                    } else {
+                        pattern.append(".*");
+                    }
+                } else {
+                    pattern.append("[^/]*");
+                }
+            } else if (c == '?') {
+                pattern.append("[^/]");
+            } else {
+                pattern.append(QRegularExpression::escape(QString(c)));
+            }
+        }
+
+        return Glob{
+            QRegularExpression(QRegularExpression::anchoredPattern(pattern)),
+            !norm.contains('/')
+        };
+    }
+
+    bool PboEntryFilter::matchesAny(const QList<Glob>& globs, const QString& path, const QString& fileName) {
+        for (const Glob& glob : globs) {
+            if (glob.regex.match(glob.fileNameOnly ? fileName : path).hasMatch())
+                return true;
+        }
+        return false;
+    }
+
+    QString PboEntryFilter::normalize(const QString& path) {
+        QString result = path.trimmed().toLower();
+        result.replace('\\', '/');
+        while (result.startsWith('/'))
+            result.remove(0, 1);
+        return result;
+    }
+}
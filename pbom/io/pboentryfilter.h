@@ -0,0 +1,49 @@
+#pragma once
+
+#include <QList>
+#include <QRegularExpression>
+#include <QSet>
+#include "domain/pbopath.h"
+
+namespace pboman3::io {
+    using namespace domain;
+
+    //selects the PBO entries by their paths, all the matching is case-insensitive
+    //an entry is selected if it matches any include glob or listed path (or there are none of them)
+    //and matches none of the exclude globs
+    class PboEntryFilter {
+    public:
+        //"*" matches within a path segment, "**" matches across the segments, "?" matches a single char
+        //a glob without a slash is matched against the file name only
+        void addInclude(const QString& glob);
+
+        void addExclude(const QString& glob);
+
+        //an exact entry path, "\" and "/" are both accepted as separators
+        void addPath(const QString& path);
+
+        //reads the entry paths from a text file, one per line, blank lines are skipped
+        //returns false if the file could not be read or listed no paths
+        bool addPathsFrom(const QString& file);
+
+        bool isEmpty() const;
+
+        bool matches(const PboPath& path) const;
+
+    private:
+        struct Glob {
+            QRegularExpression regex;
+            bool fileNameOnly;
+        };
+
+        QList<Glob> includes_;
+        QList<Glob> excludes_;
+        QSet<QString> paths_;
+
+        static Glob makeGlob(const QString& glob);
+
+        static bool matchesAny(const QList<Glob>& globs, const QString& path, const QString& fileName);
+
+        static QString normalize(const QString& path);
+    };
+}
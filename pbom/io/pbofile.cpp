@@ -6,36 +6,36 @@ namespace pboman3::io {
     }
 
     int PboFile::readCString(QString& value) {
-        bool found = false;
-        int len = 0;
-        startTransaction();
-        while (!atEnd()) {
-            char data;
-            if (read(&data, sizeof data) && data == 0) {
-                found = true;
-                break;
-            }
-            len++;
-        }
-        rollbackTransaction();
+        return readCString(this, value);
+    }
 
-        if (found) {
-            const auto initialPos = pos();
-            if (len) {
-                QByteArray bytes(len, Qt::Initialization::Uninitialized);
-                read(bytes.data(), len);
-                value.append(bytes);
+    int PboFile::writeCString(const QString& value) {
+        return writeCString(this, value);
+    }
+
+    int PboFile::readCString(QIODevice* device, QString& value) {
+        //the strings are short, so looking for the terminator in a peeked chunk beats reading byte by byte
+        constexpr qint64 chunkSize = 256;
+        qint64 scanned = 0;
+        while (true) {
+            const QByteArray chunk = device->peek(scanned + chunkSize);
+            const qsizetype zero = chunk.indexOf('\0', scanned);
+            if (zero >= 0) {
+                if (zero)
+                    value.append(QString::fromUtf8(chunk.constData(), zero));
+                device->skip(zero + 1);
+                return static_cast<int>(zero + 1);
             }
-            seek(pos() + 1);
-            return static_cast<int>(pos() - initialPos);
+            if (chunk.size() < scanned + chunkSize)
+                return 0;
+            scanned = chunk.size();
         }
-        return 0;
     }
 
-    int PboFile::writeCString(const QString& value) {
-        write(value.toUtf8());
+    int PboFile::writeCString(QIODevice* device, const QString& value) {
+        device->write(value.toUtf8());
         constexpr char zero = 0;
-        write(&zero, sizeof zero);
+        device->write(&zero, sizeof zero);
         return static_cast<int>(value.length() + sizeof zero);
     }
 }
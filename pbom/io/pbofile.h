@@ -11,5 +11,10 @@ namespace pboman3::io {
         int readCString(QString& value);
 
         int writeCString(const QString& value);
+
+        //the same for a device other than a PboFile, e.g. a buffer or a pipe
+        static int readCString(QIODevice* device, QString& value);
+
+        static int writeCString(QIODevice* device, const QString& value);
     };
 }
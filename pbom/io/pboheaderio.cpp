@@ -4,12 +4,12 @@
 namespace pboman3::io {
     using namespace std;
 
-    PboHeaderIO::PboHeaderIO(PboFile* file)
-        : file_(file) {
+    PboHeaderIO::PboHeaderIO(QIODevice* device)
+        : device_(device) {
     }
 
     QSharedPointer<PboNodeEntity> PboHeaderIO::readNextEntry() const {
-        PboDataStream data(file_);
+        PboDataStream data(device_);
 
         try {
             QString fileName;
@@ -37,7 +37,7 @@ namespace pboman3::io {
     }
 
     QSharedPointer<PboHeaderEntity> PboHeaderIO::readNextHeader() const {
-        PboDataStream data(file_);
+        PboDataStream data(device_);
 
         try {
             QString name;
@@ -56,7 +56,7 @@ namespace pboman3::io {
     }
 
     void PboHeaderIO::writeEntry(const PboNodeEntity& entry) const {
-        PboDataStream data(file_);
+        PboDataStream data(device_);
 
         data << entry.fileName();
         data << entry.packingMethod();
@@ -67,7 +67,7 @@ namespace pboman3::io {
     }
 
     void PboHeaderIO::writeHeader(const PboHeaderEntity& header) const {
-        PboDataStream data(file_);
+        PboDataStream data(device_);
 
         if (header.isBoundary()) {
             data << static_cast<quint8>(0);
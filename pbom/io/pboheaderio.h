@@ -10,7 +10,7 @@ namespace pboman3::io {
 
     class PboHeaderIO {
     public:
-        explicit PboHeaderIO(PboFile* file);
+        explicit PboHeaderIO(QIODevice* device);
 
         QSharedPointer<PboNodeEntity> readNextEntry() const;
 
@@ -21,6 +21,6 @@ namespace pboman3::io {
         void writeHeader(const PboHeaderEntity& header) const;
 
     private:
-        PboFile* file_;
+        QIODevice* device_;
     };
 }
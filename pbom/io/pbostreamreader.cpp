@@ -0,0 +1,170 @@
+#include "pbostreamreader.h"
+#include <cstring>
+#include "pbofileformatexception.h"
+#include "util/log.h"
+
+#define LOG(...) LOGGER("io/PboStreamReader", __VA_ARGS__)
+
+namespace pboman3::io {
+    //a header string longer than this is taken for garbage rather than buffered indefinitely
+    constexpr qsizetype maxCStringLength = 64 * 1024;
+
+    PboStreamReader::PboStreamReader(QIODevice* source, qsizetype bufferSize)
+        : source_(source),
+          bufferPos_(0),
+          bufferSize_(bufferSize),
+          consumed_(0),
+          sha1_(QCryptographicHash::Sha1) {
+        buffer_.reserve(bufferSize_);
+    }
+
+    PboFileHeader PboStreamReader::readHeader() {
+        QList<QSharedPointer<PboHeaderEntity>> headers;
+        QList<QSharedPointer<PboNodeEntity>> entries;
+
+        auto readNextEntry = [this]() {
+            return QSharedPointer<PboNodeEntity>(new PboNodeEntity(readEntry()));
+        };
+
+        QSharedPointer<PboNodeEntity> entry = readNextEntry();
+        if (entry->isSignature()) {
+            while (true) {
+                const QByteArray name = readCString();
+                if (name.isEmpty())
+                    break;
+                const QByteArray value = readCString();
+                headers.append(QSharedPointer<PboHeaderEntity>(
+                    new PboHeaderEntity(QString::fromUtf8(name), QString::fromUtf8(value))));
+            }
+        } else if (entry->isContent()) {
+            entries.append(entry);
+        } else {
+            throw PboFileFormatException("The file first entry is corrupted.");
+        }
+
+        entry = readNextEntry();
+        while (!entry->isBoundary()) {
+            entries.append(entry);
+            entry = readNextEntry();
+        }
+
+        LOG(info, "Read the header, Headers=", headers.count(), "Entries=", entries.count())
+
+        return PboFileHeader{headers, entries, consumed_, QByteArray()};
+    }
+
+    void PboStreamReader::readData(QIODevice* target, qint64 length, const Cancel& cancel) {
+        while (length > 0 && !cancel()) {
+            const qsizetype available = fill(1);
+            if (!available)
+                throw PboFileFormatException("The stream ended within the data block.");
+            const qsizetype chunk = available < length ? available : static_cast<qsizetype>(length);
+            target->write(consume(chunk), chunk);
+            length -= chunk;
+        }
+    }
+
+    QByteArray PboStreamReader::readData(qint64 length) {
+        if (fill(length) < length)
+            throw PboFileFormatException("The stream ended within the data block.");
+        return QByteArray(consume(length), length);
+    }
+
+    void PboStreamReader::skipData(qint64 length, const Cancel& cancel) {
+        while (length > 0 && !cancel()) {
+            const qsizetype available = fill(1);
+            if (!available)
+                throw PboFileFormatException("The stream ended within the data block.");
+            const qsizetype chunk = available < length ? available : static_cast<qsizetype>(length);
+            consume(chunk);
+            length -= chunk;
+        }
+    }
+
+    bool PboStreamReader::verifySignature(QByteArray* signature) {
+        constexpr qsizetype sha1Size = 20;
+        if (fill(1 + sha1Size) < 1 + sha1Size) {
+            LOG(warning, "The stream ended before the signature")
+            return false;
+        }
+        consume(1, false); //the 0-byte between the data end and the signature start
+        *signature = QByteArray(consume(sha1Size, false), sha1Size);
+
+        const QByteArray actual = sha1_.result();
+        LOG(info, "Expected signature:", signature->toHex(), "Actual:", actual.toHex())
+        return actual == *signature;
+    }
+
+    qsizetype PboStreamReader::fill(qsizetype length) {
+        qsizetype available = buffer_.size() - bufferPos_;
+        if (available >= length)
+            return available;
+
+        if (bufferPos_) {
+            buffer_.remove(0, bufferPos_);
+            bufferPos_ = 0;
+        }
+
+        const qsizetype wanted = length > bufferSize_ ? length : bufferSize_;
+        while (available < length) {
+            buffer_.resize(wanted);
+            const qint64 read = source_->read(buffer_.data() + available, wanted - available);
+            if (read < 0 || (read == 0 && !source_->waitForReadyRead(-1))) {
+                buffer_.resize(available);
+                break;
+            }
+            available += read;
+            buffer_.resize(available);
+        }
+
+        return available;
+    }
+
+    const char* PboStreamReader::consume(qsizetype length, bool hash) {
+        assert(buffer_.size() - bufferPos_ >= length);
+        const char* data = buffer_.constData() + bufferPos_;
+        if (hash)
+            sha1_.addData(data, length);
+        bufferPos_ += length;
+        consumed_ += length;
+        return data;
+    }
+
+    QByteArray PboStreamReader::readCString() {
+        qsizetype scanned = 0;
+        while (true) {
+            const qsizetype available = fill(scanned + 1);
+            const char* start = buffer_.constData() + bufferPos_;
+            const void* zero = memchr(start + scanned, '\0', available - scanned);
+            if (zero) {
+                const qsizetype length = static_cast<const char*>(zero) - start;
+                QByteArray value(consume(length + 1), length);
+                return value;
+            }
+            if (available == scanned)
+                throw PboFileFormatException("The stream ended within the file header.");
+            if (available > maxCStringLength)
+                throw PboFileFormatException("The file headers are corrupted.");
+            scanned = available;
+        }
+    }
+
+    template <typename T>
+    T PboStreamReader::readValue() {
+        if (fill(sizeof(T)) < static_cast<qsizetype>(sizeof(T)))
+            throw PboFileFormatException("The stream ended within the file header.");
+        T value;
+        memcpy(&value, consume(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    PboNodeEntity PboStreamReader::readEntry() {
+        const QString fileName = QString::fromUtf8(readCString());
+        const auto packingMethod = readValue<PboPackingMethod>();
+        const auto originalSize = readValue<qint32>();
+        const auto reserved = readValue<qint32>();
+        const auto timestamp = readValue<qint32>();
+        const auto dataSize = readValue<qint32>();
+        return PboNodeEntity(fileName, packingMethod, originalSize, reserved, timestamp, dataSize);
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <QCryptographicHash>
+#include <QIODevice>
+#include "pboheaderreader.h"
+#include "util/util.h"
+
+namespace pboman3::io {
+    using namespace util;
+
+    //reads a PBO strictly forward from a sequential device, e.g. stdin or a socket, nothing is ever seeked
+    //the bytes are hashed as they are consumed, so the signature is verified without a second pass
+    class PboStreamReader {
+    public:
+        explicit PboStreamReader(QIODevice* source, qsizetype bufferSize = 1024 * 1024);
+
+        //reads the headers and the entries list, the signature is not known until verifySignature()
+        //throws PboFileFormatException if the header is corrupted or the stream ends within it
+        PboFileHeader readHeader();
+
+        //the data of the entries follow one another in the header order, each must be read or skipped in turn
+        void readData(QIODevice* target, qint64 length, const Cancel& cancel);
+
+        QByteArray readData(qint64 length);
+
+        void skipData(qint64 length, const Cancel& cancel);
+
+        //reads the zero byte and the signature after the data block
+        //returns false if the stream ended before the signature or the signature did not match the contents
+        bool verifySignature(QByteArray* signature);
+
+    private:
+        QIODevice* source_;
+        QByteArray buffer_;
+        qsizetype bufferPos_;
+        qsizetype bufferSize_;
+        qsizetype consumed_;
+        QCryptographicHash sha1_;
+
+        //makes at least the given number of bytes available in the buffer, returns less if the stream ended
+        qsizetype fill(qsizetype length);
+
+        const char* consume(qsizetype length, bool hash = true);
+
+        QByteArray readCString();
+
+        template <typename T>
+        T readValue();
+
+        PboNodeEntity readEntry();
+    };
+}
@@ -0,0 +1,232 @@
+#include "streamdocumentwriter.h"
+#include <QBuffer>
+#include <QFileInfo>
+#include "diskaccessexception.h"
+#include "pboheaderentity.h"
+#include "pboheaderio.h"
+#include "bs/fslzhbinarysource.h"
+#include "bs/pbobinarysource.h"
+#include "util/executionpools.h"
+#include "util/log.h"
+#include "util/orderedrun.h"
+#include "util/tracer.h"
+
+#define LOG(...) LOGGER("io/StreamDocumentWriter", __VA_ARGS__)
+
+namespace pboman3::io {
+    namespace {
+        //passes the bytes to the target hashing and counting them on the way
+        class HashingWriter : public QIODevice {
+        public:
+            HashingWriter(QIODevice* target, QCryptographicHash* hash)
+                : target_(target),
+                  hash_(hash),
+                  written_(0) {
+                open(QIODeviceBase::WriteOnly | QIODeviceBase::Unbuffered);
+            }
+
+            bool isSequential() const override {
+                return true;
+            }
+
+            qint64 written() const {
+                return written_;
+            }
+
+        protected:
+            qint64 readData(char*, qint64) override {
+                return -1;
+            }
+
+            qint64 writeData(const char* data, qint64 length) override {
+                const qint64 written = target_->write(data, length);
+                if (written > 0) {
+                    hash_->addData(data, written);
+                    written_ += written;
+                }
+                return written;
+            }
+
+        private:
+            QIODevice* target_;
+            QCryptographicHash* hash_;
+            qint64 written_;
+        };
+    }
+
+    StreamDocumentWriter::StreamDocumentWriter(QIODevice* target)
+        : target_(target),
+          stats_(nullptr),
+          onEntryWritten_(nullptr) {
+    }
+
+    void StreamDocumentWriter::setStats(TaskStats* stats) {
+        stats_ = stats;
+    }
+
+    void StreamDocumentWriter::setOnEntryWritten(std::function<void()>* callback) {
+        onEntryWritten_ = callback;
+    }
+
+    void StreamDocumentWriter::write(PboDocument* document, const Cancel& cancel) {
+        assert(document && "Document must not be null");
+
+        QList<PboNode*> nodes;
+        collectFileNodes(document->root(), nodes);
+
+        QList<QByteArray> compressed(nodes.count());
+        compressNodes(nodes, compressed, cancel);
+        if (cancel()) {
+            LOG(info, "Cancel - return")
+            return;
+        }
+
+        QList<QSharedPointer<PboNodeEntity>> entries;
+        entries.reserve(nodes.count());
+        qint64 inputBytes = 0;
+        for (qsizetype i = 0; i < nodes.count(); i++) {
+            const PboNode* node = nodes.at(i);
+            const bool isLzh = dynamic_cast<FsLzhBinarySource*>(node->binarySource.get());
+            entries.append(makeEntry(node, isLzh ? static_cast<qint32>(compressed.at(i).size()) : readDataSize(node)));
+            inputBytes += entries.last()->originalSize() ? entries.last()->originalSize() : entries.last()->dataSize();
+        }
+
+        QCryptographicHash sha1(QCryptographicHash::Sha1);
+        HashingWriter writer(target_, &sha1);
+
+        LOG(info, "Writing headers")
+        {
+            TRACE_SCOPE("pack", "write header")
+            ScopedPhase phase(stats_, "write header");
+            const PboHeaderIO io(&writer);
+            io.writeEntry(PboNodeEntity::makeSignature());
+            for (const DocumentHeader* header : *document->headers())
+                io.writeHeader(PboHeaderEntity(header->name(), header->value()));
+            io.writeHeader(PboHeaderEntity::makeBoundary());
+            for (const QSharedPointer<PboNodeEntity>& entry : entries)
+                io.writeEntry(*entry);
+            io.writeEntry(PboNodeEntity::makeBoundary());
+            phase.addBytes(0, writer.written());
+        }
+
+        LOG(info, "Writing entries")
+        {
+            TRACE_SCOPE("pack", "write entries")
+            ScopedPhase phase(stats_, "write entries");
+            const qint64 bodyStart = writer.written();
+            for (qsizetype i = 0; i < nodes.count(); i++) {
+                if (cancel()) {
+                    LOG(info, "Cancel - return")
+                    return;
+                }
+
+                PboNode* node = nodes.at(i);
+                TRACE_SCOPE("pack", "write", node->title())
+                const qint64 before = writer.written();
+                if (dynamic_cast<FsLzhBinarySource*>(node->binarySource.get())) {
+                    writer.write(compressed.at(i));
+                    compressed[i] = QByteArray();
+                } else {
+                    node->binarySource->writeToPbo(&writer, cancel);
+                }
+
+                //the header has already gone out, so an entry of a different size would make the PBO unreadable
+                if (!cancel() && writer.written() - before != entries.at(i)->dataSize()) {
+                    LOG(warning, "Written", writer.written() - before, "bytes instead of", entries.at(i)->dataSize())
+                    throw DiskAccessException("The file changed while being packed or the output could not be written.",
+                                              node->binarySource->path());
+                }
+
+                if (onEntryWritten_)
+                    (*onEntryWritten_)();
+            }
+            phase.addBytes(writer.written() - bodyStart, writer.written() - bodyStart);
+        }
+
+        LOG(info, "Writing the signature")
+        const QByteArray signature = sha1.result();
+        target_->write(QByteArray(1, 0));
+        target_->write(signature);
+        document->setSignature(signature);
+
+        if (stats_)
+            stats_->setBytes(inputBytes, writer.written() + 1 + signature.size());
+    }
+
+    void StreamDocumentWriter::collectFileNodes(PboNode* node, QList<PboNode*>& result) {
+        for (PboNode* child : *node) {
+            if (child->nodeType() == PboNodeType::File) {
+                result.append(child);
+            } else {
+                collectFileNodes(child, result);
+            }
+        }
+    }
+
+    void StreamDocumentWriter::compressNodes(const QList<PboNode*>& nodes, QList<QByteArray>& compressed,
+                                             const Cancel& cancel) const {
+        QList<qsizetype> indexes;
+        for (qsizetype i = 0; i < nodes.count(); i++) {
+            if (dynamic_cast<FsLzhBinarySource*>(nodes.at(i)->binarySource.get()))
+                indexes.append(i);
+        }
+        if (indexes.isEmpty())
+            return;
+
+        LOG(info, "Compress", indexes.count(), "nodes in memory")
+
+        struct Result {
+            QByteArray data;
+            std::exception_ptr error;
+        };
+
+        std::exception_ptr error;
+        QThreadPool* pool = util::ExecutionPools::compute();
+        util::RunOrdered<Result>(pool, pool->maxThreadCount(), indexes.count(),
+                                 [this, &nodes, &indexes, &cancel](qsizetype index) {
+                                     Result result;
+                                     if (cancel())
+                                         return result;
+                                     try {
+                                         const PboNode* node = nodes.at(indexes.at(index));
+                                         TRACE_SCOPE("pack", "compress", node->title())
+                                         ScopedPhase phase(stats_, "compress");
+                                         QBuffer buffer(&result.data);
+                                         buffer.open(QIODeviceBase::WriteOnly);
+                                         node->binarySource->writeToPbo(&buffer, cancel);
+                                         phase.addBytes(node->binarySource->readOriginalSize(), result.data.size());
+                                     } catch (...) {
+                                         result.error = std::current_exception();
+                                     }
+                                     return result;
+                                 }, [&compressed, &indexes, &error](qsizetype index, Result& result) {
+                                     if (result.error && !error)
+                                         error = result.error;
+                                     compressed[indexes.at(index)] = std::move(result.data);
+                                 });
+
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    qint32 StreamDocumentWriter::readDataSize(const PboNode* node) {
+        //a PBO entry is copied as it is stored, a file from the disk is copied as it is
+        if (const auto* bs = dynamic_cast<const PboBinarySource*>(node->binarySource.get()))
+            return bs->getInfo().dataSize;
+        return static_cast<qint32>(QFileInfo(node->binarySource->path()).size());
+    }
+
+    QSharedPointer<PboNodeEntity> StreamDocumentWriter::makeEntry(const PboNode* node, qint32 dataSize) {
+        const qint32 originalSize = node->binarySource->readOriginalSize();
+        const qint32 timestamp = node->binarySource->readTimestamp();
+        const bool compressed = node->binarySource->isCompressed();
+
+        return QSharedPointer<PboNodeEntity>(new PboNodeEntity(
+            node->makePath().toString(),
+            compressed ? PboPackingMethod::Packed : PboPackingMethod::Uncompressed,
+            originalSize,
+            0,
+            timestamp,
+            dataSize));
+    }
+}
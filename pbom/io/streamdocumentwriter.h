@@ -0,0 +1,42 @@
+#pragma once
+
+#include <QCryptographicHash>
+#include <QIODevice>
+#include <functional>
+#include "pbonodeentity.h"
+#include "domain/pbodocument.h"
+#include "util/taskstats.h"
+#include "util/util.h"
+
+namespace pboman3::io {
+    using namespace domain;
+
+    //writes a PBO strictly forward: the header, the body, the signature, so the target may be a pipe, e.g. stdout
+    //the header holds the size of each entry, so the entries to compress are compressed in memory up front
+    //the rest is copied right from their sources and nothing is written to the disk
+    class StreamDocumentWriter {
+    public:
+        explicit StreamDocumentWriter(QIODevice* target);
+
+        //throws DiskAccessException if a source could not be read or the target could not be written
+        void write(PboDocument* document, const Cancel& cancel);
+
+        void setStats(TaskStats* stats);
+
+        //invoked after each entry has been written to the target
+        void setOnEntryWritten(std::function<void()>* callback);
+
+    private:
+        QIODevice* target_;
+        TaskStats* stats_;
+        std::function<void()>* onEntryWritten_;
+
+        static void collectFileNodes(PboNode* node, QList<PboNode*>& result);
+
+        void compressNodes(const QList<PboNode*>& nodes, QList<QByteArray>& compressed, const Cancel& cancel) const;
+
+        static qint32 readDataSize(const PboNode* node);
+
+        static QSharedPointer<PboNodeEntity> makeEntry(const PboNode* node, qint32 dataSize);
+    };
+}
@@ -10,9 +10,11 @@
 #include "ui/packwindow.h"
 #include "ui/unpackwindow.h"
 #include "exception.h"
+#include "model/task/batchtaskrunner.h"
 #include "model/task/packtask.h"
 #include "model/task/unpacktask.h"
 #include "util/log.h"
+#include "util/tracer.h"
 
 #define LOG(...) LOGGER("Main", __VA_ARGS__)
 
@@ -124,24 +126,63 @@ namespace pboman3 {
         return exitCode;
     }
 
-    int RunConsolePackOperation(const QStringList& folders, const QString& outputDir) {
+    model::task::BatchTaskRunner::StatsFormat GetStatsFormat(const CommandLine::PackCommandBase& command) {
+        using StatsFormat = model::task::BatchTaskRunner::StatsFormat;
+        if (!command.stats())
+            return StatsFormat::None;
+        return command.statsFormat == "json" ? StatsFormat::Json : StatsFormat::Table;
+    }
+
+    bool GetEntryFilter(const CommandLine::CommandUnpack& command, io::PboEntryFilter& filter) {
+        for (const string& glob : command.includes)
+            filter.addInclude(CommandLine::toQt(glob));
+        for (const string& glob : command.excludes)
+            filter.addExclude(CommandLine::toQt(glob));
+        if (command.hasFilesFrom() && !filter.addPathsFrom(CommandLine::toQt(command.filesFrom))) {
+            cerr << "Could not read any entry paths from the file: " << command.filesFrom << endl;
+            return false;
+        }
+        return true;
+    }
+
+    QString GetTracePath(const CommandLine::Result& commandLine) {
+        //PBOM_TRACE takes precedence: stopping the tracer for --trace would take its events and end its session early
+        if (util::Tracer::isEnabled()) {
+            if ((commandLine.pack.hasBeenSet() && commandLine.pack.hasTracePath())
+                || (commandLine.unpack.hasBeenSet() && commandLine.unpack.hasTracePath()))
+                cerr << "The --trace option is ignored as PBOM_TRACE is set" << endl;
+            return "";
+        }
+        if (commandLine.pack.hasBeenSet() && commandLine.pack.hasTracePath())
+            return CommandLine::toQt(commandLine.pack.tracePath);
+        if (commandLine.unpack.hasBeenSet() && commandLine.unpack.hasTracePath())
+            return CommandLine::toQt(commandLine.unpack.tracePath);
+        return "";
+    }
+
+    int RunConsolePackOperation(const QStringList& folders, const QString& outputDir, int jobs,
+                                model::task::BatchTaskRunner::StatsFormat statsFormat) {
         util::UseLoggingMessagePattern();
+        model::task::BatchTaskRunner runner(jobs);
+        runner.setStatsFormat(statsFormat);
         for (const QString& folder : folders) {
-            //don't parallelize to avoid mess in the console
-            model::task::PackTask task(folder, outputDir);
-            task.execute([] { return false; });
+            runner.addTask(QSharedPointer<model::task::Task>(new model::task::PackTask(folder, outputDir)), folder);
         }
-        return 0;
+        const int exitCode = runner.run(cout);
+        return exitCode;
     }
 
-    int RunConsoleUnpackOperation(const QStringList& folders, const QString& outputDir) {
+    int RunConsoleUnpackOperation(const QStringList& folders, const QString& outputDir, int jobs,
+                                  model::task::BatchTaskRunner::StatsFormat statsFormat,
+                                  const io::PboEntryFilter& filter) {
         util::UseLoggingMessagePattern();
+        model::task::BatchTaskRunner runner(jobs);
+        runner.setStatsFormat(statsFormat);
         for (const QString& folder : folders) {
-            //don't parallelize to avoid mess in the console
-            model::task::UnpackTask task(folder, outputDir);
-            task.execute([] { return false; });
+            runner.addTask(QSharedPointer<model::task::Task>(new model::task::UnpackTask(folder, outputDir, filter)), folder);
         }
-        return 0;
+        const int exitCode = runner.run(cout);
+        return exitCode;
     }
 
     int RunWithCliOptions(int argc, char* argv[]) {
@@ -173,7 +214,13 @@ namespace pboman3 {
 
                 const QStringList folders = CommandLine::toQt(commandLine->pack.folders);
                 if (commandLine->pack.noUi()) {
-                    exitCode = RunConsolePackOperation(folders, outputDir);
+                    const QString tracePath = GetTracePath(*commandLine);
+                    if (!tracePath.isEmpty())
+                        util::Tracer::start();
+                    exitCode = RunConsolePackOperation(folders, outputDir, commandLine->pack.jobs,
+                                                       GetStatsFormat(commandLine->pack));
+                    if (!tracePath.isEmpty() && !util::Tracer::stopAndWrite(tracePath))
+                        cerr << "Could not write the trace file: " << tracePath.toStdString() << endl;
                 }
                 else {
                     const PboApplication app(argc, argv);
@@ -189,8 +236,17 @@ namespace pboman3 {
                     outputDir = QDir::currentPath();
 
                 const QStringList files = CommandLine::toQt(commandLine->unpack.files);
-                if (commandLine->unpack.noUi()) {
-                    exitCode = RunConsoleUnpackOperation(files, outputDir);   
+                io::PboEntryFilter filter;
+                if (commandLine->unpack.noUi() && !GetEntryFilter(commandLine->unpack, filter)) {
+                    exitCode = 1;
+                } else if (commandLine->unpack.noUi()) {
+                    const QString tracePath = GetTracePath(*commandLine);
+                    if (!tracePath.isEmpty())
+                        util::Tracer::start();
+                    exitCode = RunConsoleUnpackOperation(files, outputDir, commandLine->unpack.jobs,
+                                                         GetStatsFormat(commandLine->unpack), filter);
+                    if (!tracePath.isEmpty() && !util::Tracer::stopAndWrite(tracePath))
+                        cerr << "Could not write the trace file: " << tracePath.toStdString() << endl;
                 } else {
                     const PboApplication app(argc, argv);
                     exitCode = RunUnpackWindow(app, files, outputDir);
@@ -205,6 +261,11 @@ namespace pboman3 {
     }
 
     int RunMain(int argc, char* argv[]) {
+        //PBOM_TRACE=<file> records the timeline of the whole session, including the UI-driven operations
+        const QString tracePath = qEnvironmentVariable("PBOM_TRACE");
+        if (!tracePath.isEmpty())
+            util::Tracer::start();
+
         int exitCode;
         if (argc == 2) {
             //an escape hatch for those who won't install the app via the installer
@@ -223,6 +284,9 @@ namespace pboman3 {
         } else {
             exitCode = RunWithCliOptions(argc, argv);
         }
+
+        if (!tracePath.isEmpty())
+            util::Tracer::stopAndWrite(tracePath);
         return exitCode;
     }
 }
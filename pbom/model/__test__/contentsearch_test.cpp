@@ -0,0 +1,91 @@
+#include "model/contentsearch.h"
+#include <QTemporaryDir>
+#include <gtest/gtest.h>
+#include "io/documentreader.h"
+#include "io/documentwriter.h"
+#include "io/bs/fslzhbinarysource.h"
+#include "io/bs/fsrawbinarysource.h"
+
+namespace pboman3::model::test {
+    using namespace io;
+
+    TEST(ContentSearchTest, Search_Finds_Substring_Lines) {
+        const ContentSearch search("myVar", false, true);
+        const QList<ContentMatch> matches = search.search(PboPath("init.sqf"),
+                                                          "private _a = 1;\r\nmyVar = 2;\r\n_b = myVar + myVar;\r\nmyvar");
+
+        ASSERT_EQ(matches.count(), 2);
+        ASSERT_EQ(matches.at(0).path, PboPath("init.sqf"));
+        ASSERT_EQ(matches.at(0).line, 2);
+        ASSERT_EQ(matches.at(0).text, "myVar = 2;");
+        ASSERT_EQ(matches.at(1).line, 3);
+        ASSERT_EQ(matches.at(1).text, "_b = myVar + myVar;");
+    }
+
+    TEST(ContentSearchTest, Search_Ignores_Case) {
+        const ContentSearch search("MYVAR", false, false);
+        const QList<ContentMatch> matches = search.search(PboPath("init.sqf"), "myVar = 2;\nmyvar = 3;\nother");
+
+        ASSERT_EQ(matches.count(), 2);
+        ASSERT_EQ(matches.at(0).line, 1);
+        ASSERT_EQ(matches.at(1).line, 2);
+    }
+
+    TEST(ContentSearchTest, Search_Finds_Regex_Lines) {
+        const ContentSearch search(R"(^\s*call\s+fnc_\w+)", true, true);
+        const QList<ContentMatch> matches = search.search(PboPath("init.sqf"),
+                                                          "call fnc_a;\nspawn fnc_b;\n  call  fnc_c;");
+
+        ASSERT_EQ(matches.count(), 2);
+        ASSERT_EQ(matches.at(0).line, 1);
+        ASSERT_EQ(matches.at(1).line, 3);
+        ASSERT_EQ(matches.at(1).text, "call  fnc_c;");
+    }
+
+    TEST(ContentSearchTest, IsValid_Returns_False_For_Bad_Regex) {
+        const ContentSearch search("(unclosed", true, true);
+        ASSERT_FALSE(search.isValid());
+        ASSERT_FALSE(search.errorString().isEmpty());
+    }
+
+    TEST(ContentSearchTest, Run_Searches_Compressed_Entries_In_Order) {
+        QTemporaryDir temp;
+        PboDocument document("file.pbo");
+        for (int i = 0; i < 10; i++) {
+            QByteArray content;
+            for (int j = 0; j < 100; j++)
+                content.append("_line = ").append(QByteArray::number(j)).append(";\r\n");
+            content.append("target = ").append(QByteArray::number(i)).append(";\r\n");
+
+            const QString path = temp.filePath("e" + QString::number(i) + ".sqf");
+            QFile file(path);
+            file.open(QIODeviceBase::WriteOnly);
+            file.write(content);
+            file.close();
+
+            PboNode* node = document.root()->createHierarchy(PboPath("scripts/e" + QString::number(i) + ".sqf"));
+            node->binarySource = i % 2
+                                     ? QSharedPointer<BinarySource>(new FsLzhBinarySource(path))
+                                     : QSharedPointer<BinarySource>(new FsRawBinarySource(path));
+            node->binarySource->open();
+        }
+
+        const QString pboPath = temp.filePath("file.pbo");
+        DocumentWriter writer(pboPath);
+        writer.write(&document, []() { return false; });
+
+        const QSharedPointer<PboDocument> read = DocumentReader(pboPath).read();
+        const ContentSearch search("target =", false, true);
+        QList<ContentMatch> matches;
+        search.run(ContentSearch::collectEntries(read->root()), [&matches](const ContentMatch& match) {
+            matches.append(match);
+        }, []() { return false; });
+
+        ASSERT_EQ(matches.count(), 10);
+        for (int i = 0; i < 10; i++) {
+            ASSERT_EQ(matches.at(i).path, PboPath("scripts/e" + QString::number(i) + ".sqf"));
+            ASSERT_EQ(matches.at(i).line, 101);
+            ASSERT_EQ(matches.at(i).text, "target = " + QString::number(i) + ";");
+        }
+    }
+}
@@ -0,0 +1,140 @@
+#include "model/pbodiff.h"
+#include <QTemporaryDir>
+#include <sstream>
+#include <gtest/gtest.h>
+#include "io/__test__/testpbobuilder.h"
+
+namespace pboman3::model::test {
+    class PboDiffTest : public testing::Test {
+    protected:
+        struct TestEntry {
+            QString path;
+            QByteArray content;
+            bool compressed;
+            qint64 timestamp;
+        };
+
+        QTemporaryDir temp_;
+
+        QString writePbo(const QString& name, const QList<TestEntry>& entries,
+                         const QList<QPair<QString, QString>>& headers) const {
+            io::test::TestPboBuilder builder(temp_.path());
+            for (const auto& [headerName, headerValue] : headers)
+                builder.addHeader(headerName, headerValue);
+            for (const TestEntry& entry : entries)
+                builder.addEntry(entry.path, entry.content, entry.compressed, entry.timestamp);
+            return builder.write(name);
+        }
+
+        static QByteArray text(const QByteArray& line) {
+            QByteArray result;
+            for (int i = 0; i < 200; i++)
+                result.append(line).append(QByteArray::number(i % 5)).append("\r\n");
+            return result;
+        }
+    };
+
+    TEST_F(PboDiffTest, Diff_Finds_No_Changes_In_Same_Files) {
+        const QList<TestEntry> entries{
+            {"e1.txt", "content 1", false, 1000},
+            {"e2.txt", text("content 2"), true, 1000}
+        };
+        const QString a = writePbo("a.pbo", entries, {{"prefix", "some\\prefix"}});
+        const QString b = writePbo("b.pbo", entries, {{"prefix", "some\\prefix"}});
+
+        ASSERT_TRUE(PboDiff::diff(a, b).isEmpty());
+    }
+
+    TEST_F(PboDiffTest, Diff_Finds_Entry_And_Header_Changes) {
+        const QString a = writePbo("a.pbo", {
+                                       {"e1.txt", "content 1", false, 1000},
+                                       {"e2.txt", "content 2", false, 1000},
+                                       {"e3.txt", "content 3", false, 1000}
+                                   }, {{"prefix", "prefix1"}, {"removed", "value1"}});
+        const QString b = writePbo("b.pbo", {
+                                       {"e1.txt", "content 1", false, 1000},
+                                       {"e2.txt", "content X", false, 2000},
+                                       {"e4.txt", "content 4", false, 1000}
+                                   }, {{"prefix", "prefix2"}, {"added", "value2"}});
+
+        const QList<PboDiff::Change> changes = PboDiff::diff(a, b);
+
+        ASSERT_EQ(changes.count(), 6);
+        ASSERT_EQ(changes.at(0).kind, PboDiff::Change::Kind::HeaderChanged);
+        ASSERT_EQ(changes.at(0).subject, "prefix");
+        ASSERT_EQ(changes.at(0).details, "prefix1 -> prefix2");
+        ASSERT_EQ(changes.at(1).kind, PboDiff::Change::Kind::HeaderRemoved);
+        ASSERT_EQ(changes.at(1).subject, "removed");
+        ASSERT_EQ(changes.at(2).kind, PboDiff::Change::Kind::HeaderAdded);
+        ASSERT_EQ(changes.at(2).subject, "added");
+        ASSERT_EQ(changes.at(3).kind, PboDiff::Change::Kind::Modified);
+        ASSERT_EQ(changes.at(3).subject, "e2.txt");
+        ASSERT_EQ(changes.at(4).kind, PboDiff::Change::Kind::Removed);
+        ASSERT_EQ(changes.at(4).subject, "e3.txt");
+        ASSERT_EQ(changes.at(5).kind, PboDiff::Change::Kind::Added);
+        ASSERT_EQ(changes.at(5).subject, "e4.txt");
+    }
+
+    TEST_F(PboDiffTest, Diff_Compares_Content_When_Packing_Differs) {
+        const QString a = writePbo("a.pbo", {
+                                       {"e1.txt", text("content 1"), true, 1000},
+                                       {"e2.txt", text("content 2"), true, 1000}
+                                   }, {});
+        const QString b = writePbo("b.pbo", {
+                                       {"e1.txt", text("content 1"), false, 2000},
+                                       {"e2.txt", text("content X"), false, 2000}
+                                   }, {});
+
+        const QList<PboDiff::Change> changes = PboDiff::diff(a, b);
+
+        ASSERT_EQ(changes.count(), 1);
+        ASSERT_EQ(changes.at(0).kind, PboDiff::Change::Kind::Modified);
+        ASSERT_EQ(changes.at(0).subject, "e2.txt");
+    }
+
+    TEST_F(PboDiffTest, Diff_Treats_Zero_Original_Size_Of_Uncompressed_Entry_As_Data_Size) {
+        const QString a = writePbo("a.pbo", {{"e1.txt", "content 1", false, 1000}}, {});
+        const QString b = writePbo("b.pbo", {{"e1.txt", "content 1", false, 1000}}, {});
+
+        //the original size follows the file name and the packing method
+        QFile file(b);
+        file.open(QIODeviceBase::ReadWrite);
+        const qsizetype entryAt = file.readAll().indexOf(QByteArray("e1.txt", 7));
+        file.seek(entryAt + 7 + 4);
+        file.write(QByteArray(4, 0));
+        file.close();
+
+        ASSERT_TRUE(PboDiff::diff(a, b).isEmpty());
+    }
+
+    TEST_F(PboDiffTest, Run_Prints_Changes_And_Returns_Exit_Code) {
+        const QString a = writePbo("a.pbo", {{"e1.txt", "content 1", false, 1000}}, {});
+        const QString b = writePbo("b.pbo", {{"e1.txt", "content 2", false, 2000}}, {});
+
+        std::ostringstream output;
+        std::ostringstream errors;
+
+        ASSERT_EQ(PboDiff::run(a, b, output, errors), 1);
+        ASSERT_EQ(output.str(), "Modified | e1.txt\n");
+        ASSERT_TRUE(errors.str().empty());
+
+        output.str("");
+        ASSERT_EQ(PboDiff::run(a, a, output, errors), 0);
+        ASSERT_TRUE(output.str().empty());
+    }
+
+    TEST_F(PboDiffTest, Run_Fails_On_Non_Pbo) {
+        const QString a = writePbo("a.pbo", {{"e1.txt", "content 1", false, 1000}}, {});
+        const QString notPbo = temp_.filePath("not.pbo");
+        QFile file(notPbo);
+        file.open(QIODeviceBase::WriteOnly);
+        file.write("garbage");
+        file.close();
+
+        std::ostringstream output;
+        std::ostringstream errors;
+
+        ASSERT_EQ(PboDiff::run(a, notPbo, output, errors), 2);
+        ASSERT_EQ(errors.str().rfind("Failed | ", 0), 0);
+    }
+}
@@ -0,0 +1,59 @@
+#include "model/pboentryprinter.h"
+#include <QBuffer>
+#include <QTemporaryDir>
+#include <sstream>
+#include <gtest/gtest.h>
+#include "io/__test__/testpbobuilder.h"
+
+namespace pboman3::model::test {
+    using namespace domain;
+
+    class PboEntryPrinterTest : public testing::Test {
+    protected:
+        QTemporaryDir temp_;
+        QString pboPath_;
+        QByteArray packed_;
+        QByteArray raw_;
+
+        void SetUp() override {
+            for (int i = 0; i < 2000; i++)
+                packed_.append(QByteArray::number(i % 17)).append(" some repeating text\r\n");
+            raw_ = QByteArray(100, 5);
+
+            pboPath_ = io::test::TestPboBuilder(temp_.path())
+                       .addEntry("f1/e1.txt", packed_, true)
+                       .addEntry("e2.bin", raw_)
+                       .write("file.pbo");
+        }
+    };
+
+    TEST_F(PboEntryPrinterTest, Print_Writes_Packed_Entry) {
+        QBuffer output;
+        output.open(QIODeviceBase::WriteOnly);
+
+        PboEntryPrinter::print(pboPath_, "F1\\E1.txt", &output, []() { return false; });
+
+        ASSERT_EQ(output.data(), packed_);
+    }
+
+    TEST_F(PboEntryPrinterTest, Print_Writes_Raw_Entry) {
+        QBuffer output;
+        output.open(QIODeviceBase::WriteOnly);
+
+        PboEntryPrinter::print(pboPath_, "e2.bin", &output, []() { return false; });
+
+        ASSERT_EQ(output.data(), raw_);
+    }
+
+    TEST_F(PboEntryPrinterTest, Run_Fails_If_No_Entry) {
+        QBuffer output;
+        output.open(QIODeviceBase::WriteOnly);
+        std::ostringstream errors;
+
+        const int exitCode = PboEntryPrinter::run(pboPath_, "e3.bin", &output, errors);
+
+        ASSERT_EQ(exitCode, 1);
+        ASSERT_TRUE(output.data().isEmpty());
+        ASSERT_FALSE(errors.str().empty());
+    }
+}
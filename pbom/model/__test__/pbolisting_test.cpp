@@ -0,0 +1,93 @@
+#include "model/pbolisting.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <sstream>
+#include <gtest/gtest.h>
+#include "io/__test__/testpbobuilder.h"
+
+namespace pboman3::model::test {
+    using namespace domain;
+
+    class PboListingTest : public testing::Test {
+    protected:
+        QTemporaryDir temp_;
+        QString pboPath_;
+
+        void SetUp() override {
+            pboPath_ = io::test::TestPboBuilder(temp_.path())
+                       .addHeader("prefix", "some\\prefix")
+                       .addEntry("e1.txt", QByteArray(15, 1))
+                       .addEntry("f2/e2.txt", QByteArray(10, 2))
+                       .write("file.pbo");
+        }
+    };
+
+    TEST_F(PboListingTest, Run_Prints_A_Line_Per_Entry) {
+        const PboListing listing(PboListing::Format::Text, 1);
+
+        std::ostringstream output;
+        std::ostringstream errors;
+        const int exitCode = listing.run(QStringList{pboPath_}, output, errors);
+
+        ASSERT_EQ(exitCode, 0);
+        ASSERT_TRUE(errors.str().empty());
+
+        const QStringList lines = QString::fromStdString(output.str()).split('\n', Qt::SkipEmptyParts);
+        ASSERT_EQ(lines.count(), 2);
+
+        const QStringList first = lines.at(0).split('\t');
+        ASSERT_EQ(first.count(), 7);
+        ASSERT_EQ(first.at(0), pboPath_);
+        ASSERT_EQ(first.at(1), "f2/e2.txt");
+        ASSERT_EQ(first.at(2), "uncompressed");
+        ASSERT_EQ(first.at(4), "10");
+
+        const QStringList second = lines.at(1).split('\t');
+        ASSERT_EQ(second.at(1), "e1.txt");
+        ASSERT_EQ(second.at(4), "15");
+        ASSERT_EQ(second.at(6).toLongLong(), first.at(6).toLongLong() + 10);
+    }
+
+    TEST_F(PboListingTest, Run_Prints_A_Json_Object_Per_Pbo) {
+        const PboListing listing(PboListing::Format::Json, 2);
+
+        std::ostringstream output;
+        std::ostringstream errors;
+        const int exitCode = listing.run(QStringList{pboPath_, pboPath_}, output, errors);
+
+        ASSERT_EQ(exitCode, 0);
+
+        const QStringList lines = QString::fromStdString(output.str()).split('\n', Qt::SkipEmptyParts);
+        ASSERT_EQ(lines.count(), 2);
+
+        const QJsonObject json = QJsonDocument::fromJson(lines.at(0).toUtf8()).object();
+        ASSERT_EQ(json.value("file").toString(), pboPath_);
+        ASSERT_EQ(json.value("headers").toArray().at(0).toObject().value("value").toString(), "some\\prefix");
+
+        const QJsonArray entries = json.value("entries").toArray();
+        ASSERT_EQ(entries.count(), 2);
+        ASSERT_EQ(entries.at(1).toObject().value("path").toString(), "e1.txt");
+        ASSERT_EQ(entries.at(1).toObject().value("dataSize").toInt(), 15);
+        ASSERT_EQ(json.value("signature").toString().length(), 40);
+    }
+
+    TEST_F(PboListingTest, Run_Reports_Files_That_Are_Not_Pbo) {
+        const QString notPbo = temp_.filePath("not.pbo");
+        QFile file(notPbo);
+        file.open(QIODeviceBase::WriteOnly);
+        file.write("garbage");
+        file.close();
+
+        const PboListing listing(PboListing::Format::Text, 1);
+
+        std::ostringstream output;
+        std::ostringstream errors;
+        const int exitCode = listing.run(QStringList{notPbo, pboPath_}, output, errors);
+
+        ASSERT_EQ(exitCode, 1);
+        ASSERT_NE(errors.str().find("Failed | " + notPbo.toStdString()), std::string::npos);
+        ASSERT_EQ(QString::fromStdString(output.str()).split('\n', Qt::SkipEmptyParts).count(), 2);
+    }
+}
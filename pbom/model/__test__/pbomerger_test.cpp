@@ -0,0 +1,113 @@
+#include "model/pbomerger.h"
+#include <QBuffer>
+#include <QTemporaryDir>
+#include <sstream>
+#include <gtest/gtest.h>
+#include "domain/func.h"
+#include "io/documentreader.h"
+#include "io/__test__/testpbobuilder.h"
+#include "io/bs/pbobinarysource.h"
+
+namespace pboman3::model::test {
+    using namespace io;
+
+    class PboMergerTest : public testing::Test {
+    protected:
+        QTemporaryDir temp_;
+
+        QString writePbo(const QString& name, const QList<QPair<QString, QByteArray>>& entries,
+                         const QString& prefix) const {
+            io::test::TestPboBuilder builder(temp_.path());
+            builder.addHeader("prefix", prefix);
+            //compress the larger entries to make sure they are copied as stored
+            for (const auto& [path, content] : entries)
+                builder.addEntry(path, content, content.size() > 100);
+            return builder.write(name);
+        }
+
+        static QByteArray readEntry(PboDocument* document, const QString& path) {
+            const PboNode* node = document->root()->get(PboPath(path));
+            QByteArray data;
+            QBuffer buffer(&data);
+            buffer.open(QIODeviceBase::WriteOnly);
+            dynamic_cast<PboBinarySource*>(node->binarySource.get())->writeToStream(&buffer, []() { return false; });
+            return data;
+        }
+
+        static QByteArray text(const QByteArray& line) {
+            QByteArray result;
+            for (int i = 0; i < 100; i++)
+                result.append(line).append(QByteArray::number(i % 5)).append("\r\n");
+            return result;
+        }
+    };
+
+    TEST_F(PboMergerTest, Merge_Skips_Conflicting_Entries) {
+        const QString a = writePbo("a.pbo", {{"common.txt", "content a"}, {"a/file.txt", text("file a")}}, "prefix_a");
+        const QString b = writePbo("b.pbo", {{"common.txt", "content b"}, {"b/file.txt", text("file b")}}, "prefix_b");
+        const QString output = temp_.filePath("output.pbo");
+
+        const qsizetype conflicts = PboMerger::merge(QStringList{a, b}, output, ConflictResolution::Skip,
+                                                     []() { return false; });
+
+        ASSERT_EQ(conflicts, 1);
+
+        const QSharedPointer<PboDocument> merged = DocumentReader(output).read();
+        qint32 count = 0;
+        CountFilesInTree(*merged->root(), count);
+        ASSERT_EQ(count, 3);
+        ASSERT_EQ(readEntry(merged.get(), "common.txt"), "content a");
+        ASSERT_EQ(readEntry(merged.get(), "a/file.txt"), text("file a"));
+        ASSERT_EQ(readEntry(merged.get(), "b/file.txt"), text("file b"));
+
+        ASSERT_EQ(merged->headers()->count(), 1);
+        ASSERT_EQ(merged->headers()->at(0)->value(), "prefix_a");
+    }
+
+    TEST_F(PboMergerTest, Merge_Replaces_Conflicting_Entries) {
+        const QString a = writePbo("a.pbo", {{"common.txt", "content a"}}, "prefix_a");
+        const QString b = writePbo("b.pbo", {{"common.txt", "content b"}}, "prefix_b");
+        const QString output = temp_.filePath("output.pbo");
+
+        PboMerger::merge(QStringList{a, b}, output, ConflictResolution::Replace, []() { return false; });
+
+        const QSharedPointer<PboDocument> merged = DocumentReader(output).read();
+        qint32 count = 0;
+        CountFilesInTree(*merged->root(), count);
+        ASSERT_EQ(count, 1);
+        ASSERT_EQ(readEntry(merged.get(), "common.txt"), "content b");
+    }
+
+    TEST_F(PboMergerTest, Merge_Copies_Conflicting_Entries) {
+        const QString a = writePbo("a.pbo", {{"common.txt", "content a"}}, "prefix_a");
+        const QString b = writePbo("b.pbo", {{"common.txt", "content b"}}, "prefix_b");
+
+        const QSharedPointer<PboDocument> target = DocumentReader(a).read();
+        const QSharedPointer<PboDocument> source = DocumentReader(b).read();
+        const qsizetype conflicts = PboMerger::merge(target.get(), source.get(), ConflictResolution::Copy);
+
+        ASSERT_EQ(conflicts, 1);
+        qint32 count = 0;
+        CountFilesInTree(*target->root(), count);
+        ASSERT_EQ(count, 2);
+        ASSERT_EQ(readEntry(target.get(), "common.txt"), "content a");
+    }
+
+    TEST_F(PboMergerTest, Run_Fails_On_Non_Pbo) {
+        const QString a = writePbo("a.pbo", {{"common.txt", "content a"}}, "prefix_a");
+        const QString notPbo = temp_.filePath("not.pbo");
+        QFile file(notPbo);
+        file.open(QIODeviceBase::WriteOnly);
+        file.write("garbage");
+        file.close();
+
+        std::ostringstream out;
+        std::ostringstream errors;
+        const int exitCode = PboMerger::run(QStringList{a, notPbo}, temp_.filePath("output.pbo"),
+                                            ConflictResolution::Skip, out, errors);
+
+        ASSERT_EQ(exitCode, 1);
+        ASSERT_FALSE(errors.str().empty());
+        ASSERT_FALSE(QFile::exists(temp_.filePath("output.pbo")));
+    }
+}
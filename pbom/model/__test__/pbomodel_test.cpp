@@ -0,0 +1,52 @@
+#include "model/pbomodel.h"
+#include <QTemporaryDir>
+#include <gtest/gtest.h>
+#include "domain/func.h"
+#include "exception.h"
+#include "io/__test__/testpbobuilder.h"
+
+namespace pboman3::model::test {
+    class PboModelTest : public testing::Test {
+    protected:
+        QTemporaryDir temp_;
+
+        QString writePbo(const QString& name, const QStringList& entries) const {
+            io::test::TestPboBuilder builder(temp_.path());
+            for (const QString& entry : entries)
+                builder.addEntry(entry, "content of " + name.toUtf8());
+            return builder.write(name);
+        }
+    };
+
+    TEST_F(PboModelTest, MergeFiles_Adds_Entries_And_Counts_Conflicts) {
+        const QString a = writePbo("a.pbo", {"common.txt", "a.txt"});
+        const QString b = writePbo("b.pbo", {"common.txt", "b.txt"});
+        const QString c = writePbo("c.pbo", {"common.txt", "f1/c.txt"});
+
+        PboModel model;
+        model.loadFile(a);
+
+        int changes = 0;
+        QObject::connect(&model, &PboModel::modelChanged, [&changes]() { changes++; });
+
+        const qsizetype conflicts = model.mergeFiles(QStringList{b, c}, ConflictResolution::Skip);
+
+        ASSERT_EQ(conflicts, 2);
+        qint32 count = 0;
+        CountFilesInTree(*model.document()->root(), count);
+        ASSERT_EQ(count, 4);
+        ASSERT_TRUE(model.document()->root()->get(PboPath("b.txt")));
+        ASSERT_TRUE(model.document()->root()->get(PboPath("f1/c.txt")));
+        ASSERT_GT(changes, 0);
+
+        model.unloadFile();
+    }
+
+    TEST_F(PboModelTest, MergeFiles_Throws_If_Not_Loaded) {
+        const QString a = writePbo("a.pbo", {"a.txt"});
+
+        const PboModel model;
+
+        ASSERT_THROW(model.mergeFiles(QStringList{a}, ConflictResolution::Skip), InvalidOperationException);
+    }
+}
@@ -0,0 +1,98 @@
+#include "model/pborecompressor.h"
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QTemporaryDir>
+#include <gtest/gtest.h>
+#include "io/documentreader.h"
+#include "io/pboheaderreader.h"
+#include "io/__test__/testpbobuilder.h"
+#include "io/bs/pbobinarysource.h"
+#include "util/json.h"
+
+namespace pboman3::model::test {
+    using namespace domain;
+    using namespace io;
+
+    class PboRecompressorTest : public testing::Test {
+    protected:
+        QTemporaryDir temp_;
+        QString pboPath_;
+        QByteArray text_;
+
+        void SetUp() override {
+            for (int i = 0; i < 300; i++)
+                text_.append(QByteArray::number(i % 7)).append(" some repeating text\r\n");
+
+            pboPath_ = io::test::TestPboBuilder(temp_.path())
+                       .addEntry("script.sqf", text_)
+                       .addEntry("data/texture.paa", text_)
+                       .addEntry("data/config.cpp", text_)
+                       .write("file.pbo");
+        }
+
+        QString writeRules(const QByteArray& json) const {
+            const QString path = temp_.filePath("pbo.json");
+            QFile file(path);
+            file.open(QIODeviceBase::WriteOnly);
+            file.write(json);
+            file.close();
+            return path;
+        }
+
+        static QByteArray readEntry(const PboNode* node) {
+            QByteArray data;
+            QBuffer buffer(&data);
+            buffer.open(QIODeviceBase::WriteOnly);
+            dynamic_cast<PboBinarySource*>(node->binarySource.get())->writeToStream(&buffer, []() { return false; });
+            return data;
+        }
+    };
+
+    TEST_F(PboRecompressorTest, Recompress_Compresses_Selected_Entries) {
+        const QString rules = writeRules(R"({"compress":{"include":["\\.(sqf|cpp)$"],"exclude":["^data/config"]}})");
+        const QString output = temp_.filePath("output.pbo");
+
+        const qsizetype compressed = PboRecompressor::recompress(pboPath_, rules, output, []() { return false; });
+
+        ASSERT_EQ(compressed, 1);
+
+        const DocumentReader reader(output);
+        const QSharedPointer<PboDocument> document = reader.read();
+        const PboNode* script = document->root()->get(PboPath("script.sqf"));
+        const PboNode* texture = document->root()->get(PboPath("data/texture.paa"));
+        const PboNode* config = document->root()->get(PboPath("data/config.cpp"));
+
+        ASSERT_TRUE(script->binarySource->isCompressed());
+        ASSERT_FALSE(texture->binarySource->isCompressed());
+        ASSERT_FALSE(config->binarySource->isCompressed());
+
+        ASSERT_EQ(readEntry(script), text_);
+        ASSERT_EQ(readEntry(texture), text_);
+        ASSERT_EQ(readEntry(config), text_);
+    }
+
+    TEST_F(PboRecompressorTest, Recompress_Writes_Valid_Signature) {
+        const QString rules = writeRules(R"({"compress":{"include":[".*"]}})");
+        const QString output = temp_.filePath("output.pbo");
+
+        PboRecompressor::recompress(pboPath_, rules, output, []() { return false; });
+
+        PboFile file(output);
+        file.open(QIODeviceBase::ReadOnly);
+        const PboFileHeader header = PboHeaderReader::readFileHeader(&file);
+        file.seek(0);
+        const QByteArray content = file.read(file.size() - 21);
+        file.close();
+
+        ASSERT_EQ(header.signature, QCryptographicHash::hash(content, QCryptographicHash::Sha1));
+    }
+
+    TEST_F(PboRecompressorTest, Recompress_Throws_On_Invalid_Rules) {
+        const QString rules = writeRules("not a json");
+        const QString output = temp_.filePath("output.pbo");
+
+        ASSERT_THROW(PboRecompressor::recompress(pboPath_, rules, output, []() { return false; }),
+                     JsonStructureException);
+        ASSERT_FALSE(QFile::exists(output));
+    }
+}
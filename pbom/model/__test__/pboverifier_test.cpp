@@ -0,0 +1,108 @@
+#include "model/pboverifier.h"
+#include <QTemporaryDir>
+#include <sstream>
+#include <gtest/gtest.h>
+#include "io/__test__/testpbobuilder.h"
+
+namespace pboman3::model::test {
+    using namespace domain;
+
+    class PboVerifierTest : public testing::Test {
+    protected:
+        QTemporaryDir temp_;
+        QString pboPath_;
+
+        void SetUp() override {
+            QByteArray text;
+            for (int i = 0; i < 300; i++)
+                text.append(QByteArray::number(i % 7)).append(" some repeating text\r\n");
+
+            pboPath_ = io::test::TestPboBuilder(temp_.path())
+                       .addEntry("e1.txt", text, true)
+                       .addEntry("e2.bin", QByteArray(100, 2))
+                       .write("file.pbo");
+        }
+
+        void overwrite(qint64 offset, char byte) const {
+            QFile file(pboPath_);
+            file.open(QIODeviceBase::ReadWrite);
+            file.seek(offset);
+            file.write(&byte, 1);
+            file.close();
+        }
+
+        qint64 firstEntryOffset() const {
+            PboFile file(pboPath_);
+            file.open(QIODeviceBase::ReadOnly);
+            return PboHeaderReader::readFileHeader(&file).dataBlockStart;
+        }
+    };
+
+    TEST_F(PboVerifierTest, Verify_Finds_No_Problems_In_Intact_File) {
+        const PboVerifier verifier(1);
+        ASSERT_TRUE(verifier.verify(pboPath_).isEmpty());
+    }
+
+    TEST_F(PboVerifierTest, Verify_Finds_Corrupted_Compressed_Entry) {
+        //the compressed entry goes first as the entries are written in the order of the tree
+        overwrite(firstEntryOffset() + 10, 0x7f);
+
+        const PboVerifier verifier(1);
+        const QStringList problems = verifier.verify(pboPath_);
+
+        ASSERT_EQ(problems.count(), 2);
+        ASSERT_EQ(problems.at(0), "The signature does not match the contents");
+        ASSERT_TRUE(problems.at(1).contains("e1.txt"));
+    }
+
+    TEST_F(PboVerifierTest, Verify_Finds_Compressed_Entry_Not_Matching_Its_Size) {
+        //the data size is the last field of the entry header and follows the file name by 16 bytes
+        QFile file(pboPath_);
+        file.open(QIODeviceBase::ReadWrite);
+        const qint64 sizeAt = file.readAll().indexOf(QByteArray("e1.txt", 7)) + 7 + 16;
+        file.seek(sizeAt);
+        qint32 dataSize;
+        file.read(reinterpret_cast<char*>(&dataSize), sizeof dataSize);
+        dataSize--;
+        file.seek(sizeAt);
+        file.write(reinterpret_cast<const char*>(&dataSize), sizeof dataSize);
+        file.close();
+
+        const PboVerifier verifier(1);
+        const QStringList problems = verifier.verify(pboPath_);
+
+        ASSERT_EQ(problems.count(), 2);
+        ASSERT_EQ(problems.at(0), "The signature does not match the contents");
+        ASSERT_EQ(problems.at(1), "The entry data do not match the entry size: e1.txt");
+    }
+
+    TEST_F(PboVerifierTest, Verify_Finds_Truncated_File) {
+        QFile file(pboPath_);
+        file.resize(firstEntryOffset() + 20);
+
+        const PboVerifier verifier(1);
+        const QStringList problems = verifier.verify(pboPath_);
+
+        ASSERT_EQ(problems.count(), 1);
+        ASSERT_TRUE(problems.at(0).contains("beyond the end of the file"));
+    }
+
+    TEST_F(PboVerifierTest, Run_Reports_Each_File_In_Order) {
+        const QString notPbo = temp_.filePath("not.pbo");
+        QFile file(notPbo);
+        file.open(QIODeviceBase::WriteOnly);
+        file.write("garbage");
+        file.close();
+
+        const PboVerifier verifier(2);
+        std::ostringstream output;
+        const int exitCode = verifier.run(QStringList{pboPath_, notPbo, pboPath_}, output);
+
+        ASSERT_EQ(exitCode, 1);
+        const QStringList lines = QString::fromStdString(output.str()).split('\n', Qt::SkipEmptyParts);
+        ASSERT_EQ(lines.count(), 3);
+        ASSERT_EQ(lines.at(0), "OK | " + pboPath_);
+        ASSERT_TRUE(lines.at(1).startsWith("Failed | " + notPbo));
+        ASSERT_EQ(lines.at(2), "OK | " + pboPath_);
+    }
+}
@@ -3,6 +3,7 @@
 #include "exception.h"
 #include "domain/binarysource.h"
 #include "io/bs/pbobinarysource.h"
+#include "io/bs/pbolzhbinarysource.h"
 #include "io/bs/fsrawbinarysource.h"
 #include "io/bs/fslzhbinarysource.h"
 
@@ -11,7 +12,7 @@ namespace pboman3::model {
     using namespace io;
 
     inline void ChangeBinarySourceCompressionMode(QSharedPointer<BinarySource>& bs, bool compress) {
-        if (dynamic_cast<PboBinarySource*>(bs.get())) {
+        if (dynamic_cast<PboBinarySource*>(bs.get()) || dynamic_cast<PboLzhBinarySource*>(bs.get())) {
             throw InvalidOperationException("Can't query compression status");
         }
 
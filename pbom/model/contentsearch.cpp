@@ -0,0 +1,151 @@
+#include "contentsearch.h"
+#include <QBuffer>
+#include <QFile>
+#include <algorithm>
+#include "exception.h"
+#include "io/diskaccessexception.h"
+#include "io/bs/pbobinarysource.h"
+#include "util/executionpools.h"
+#include "util/log.h"
+#include "util/orderedrun.h"
+
+#define LOG(...) LOGGER("model/ContentSearch", __VA_ARGS__)
+
+namespace pboman3::model {
+    namespace {
+        constexpr qsizetype maxLineLength = 200;
+
+        QString ToText(const QByteArray& line) {
+            return QString::fromUtf8(line);
+        }
+
+        QString ToText(const QString& line) {
+            return line;
+        }
+
+        //find(from) returns the position of the next match at or after from, or -1
+        template <typename TText, typename TFind>
+        void CollectLines(const PboPath& path, const TText& text, TFind find, QList<ContentMatch>& matches) {
+            using Char = typename TText::value_type;
+            const Char newline = Char(u'\n');
+
+            qsizetype from = 0;
+            qsizetype line = 1;
+            qsizetype counted = 0;
+            while (from <= text.size()) {
+                const qsizetype pos = find(from);
+                if (pos < 0)
+                    break;
+
+                line += std::count(text.cbegin() + counted, text.cbegin() + pos, newline);
+                counted = pos;
+
+                const qsizetype start = pos > 0 ? text.lastIndexOf(newline, pos - 1) + 1 : 0;
+                qsizetype end = text.indexOf(newline, pos);
+                if (end < 0)
+                    end = text.size();
+
+                matches.append(ContentMatch{path, line, ToText(text.mid(start, std::min(end - start, maxLineLength))).trimmed()});
+                from = end + 1; //a line is reported once however many matches it has
+            }
+        }
+    }
+
+    ContentSearch::ContentSearch(const QString& pattern, bool regex, bool caseSensitive)
+        : isRegex_(regex),
+          caseSensitive_(caseSensitive) {
+        if (regex) {
+            regex_ = QRegularExpression(pattern, caseSensitive
+                                                     ? QRegularExpression::NoPatternOption
+                                                     : QRegularExpression::CaseInsensitiveOption);
+        } else {
+            text_ = caseSensitive ? pattern.toUtf8() : pattern.toUtf8().toLower();
+        }
+    }
+
+    bool ContentSearch::isValid() const {
+        return isRegex_ ? regex_.isValid() && !regex_.pattern().isEmpty() : !text_.isEmpty();
+    }
+
+    QString ContentSearch::errorString() const {
+        if (isRegex_ && !regex_.isValid())
+            return "The regular expression is invalid: " + regex_.errorString();
+        return isValid() ? "" : "The text to find is empty";
+    }
+
+    QList<ContentSearch::Entry> ContentSearch::collectEntries(const PboNode* root) {
+        QList<Entry> result;
+        collectEntries(root, result);
+        return result;
+    }
+
+    void ContentSearch::collectEntries(const PboNode* node, QList<Entry>& result) {
+        for (const PboNode* child : *node) {
+            if (child->nodeType() == PboNodeType::File) {
+                result.append(Entry{child->makePath(), child->binarySource});
+            } else {
+                collectEntries(child, result);
+            }
+        }
+    }
+
+    void ContentSearch::run(const QList<Entry>& entries, const std::function<void(const ContentMatch&)>& onMatch,
+                            const Cancel& cancel) const {
+        assert(isValid() && "The search must be valid");
+        LOG(info, "Searching", entries.count(), "entries")
+
+        QThreadPool* pool = util::ExecutionPools::compute();
+        util::RunOrdered<QList<ContentMatch>>(pool, pool->maxThreadCount(), entries.count(),
+                                              [this, &entries, &cancel](qsizetype index) {
+                                                  if (cancel())
+                                                      return QList<ContentMatch>();
+                                                  const Entry& entry = entries.at(index);
+                                                  try {
+                                                      const QByteArray content = readContent(entry.binarySource.get(), cancel);
+                                                      return search(entry.path, content);
+                                                  } catch (const AppException& ex) {
+                                                      LOG(warning, "Could not search the entry:", entry.path, ex)
+                                                      return QList<ContentMatch>();
+                                                  }
+                                              }, [&onMatch, &cancel](qsizetype, QList<ContentMatch>& matches) {
+                                                  if (cancel())
+                                                      return;
+                                                  for (const ContentMatch& match : matches)
+                                                      onMatch(match);
+                                              });
+    }
+
+    QList<ContentMatch> ContentSearch::search(const PboPath& path, const QByteArray& content) const {
+        QList<ContentMatch> matches;
+        if (isRegex_) {
+            const QString text = QString::fromUtf8(content);
+            CollectLines(path, text, [this, &text](qsizetype from) {
+                const QRegularExpressionMatch match = regex_.match(text, from);
+                return match.hasMatch() ? match.capturedStart() : -1;
+            }, matches);
+        } else {
+            const QByteArray haystack = caseSensitive_ ? content : content.toLower();
+            CollectLines(path, content, [this, &haystack](qsizetype from) {
+                return haystack.indexOf(text_, from);
+            }, matches);
+        }
+        return matches;
+    }
+
+    QByteArray ContentSearch::readContent(const BinarySource* binarySource, const Cancel& cancel) {
+        QByteArray content;
+        if (const auto* pboSource = dynamic_cast<const io::PboBinarySource*>(binarySource)) {
+            content.reserve(pboSource->readOriginalSize() ? pboSource->readOriginalSize() : pboSource->getInfo().dataSize);
+            QBuffer buffer(&content);
+            buffer.open(QIODeviceBase::WriteOnly);
+            pboSource->writeToStream(&buffer, cancel);
+        } else {
+            //a file added from the disk and not saved yet, stored as it is whatever the compression
+            QFile file(binarySource->path());
+            if (!file.open(QIODeviceBase::ReadOnly))
+                throw io::DiskAccessException("Can not read the file.", binarySource->path());
+            content = file.readAll();
+        }
+        return content;
+    }
+}
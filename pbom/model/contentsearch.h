@@ -0,0 +1,59 @@
+#pragma once
+
+#include <QRegularExpression>
+#include <functional>
+#include "domain/binarysource.h"
+#include "domain/pbonode.h"
+#include "domain/pbopath.h"
+
+namespace pboman3::model {
+    using namespace domain;
+
+    struct ContentMatch {
+        PboPath path;
+        //1-based
+        qsizetype line;
+        //the line the match was found on
+        QString text;
+
+        friend QDebug operator<<(QDebug debug, const ContentMatch& match) {
+            return debug << "ContentMatch(Path=" << match.path << ", Line=" << match.line << ")";
+        }
+    };
+
+    //looks for a substring or a regular expression in the contents of the entries
+    //the entries are decompressed in memory on several threads, nothing is written to the disk
+    class ContentSearch {
+    public:
+        struct Entry {
+            PboPath path;
+            QSharedPointer<BinarySource> binarySource;
+        };
+
+        ContentSearch(const QString& pattern, bool regex, bool caseSensitive);
+
+        bool isValid() const;
+
+        QString errorString() const;
+
+        //the entries are captured up front, so the search does not touch the tree while running
+        static QList<Entry> collectEntries(const PboNode* root);
+
+        //onMatch is invoked on the calling thread in the order of the entries, as soon as an entry has been searched
+        void run(const QList<Entry>& entries, const std::function<void(const ContentMatch&)>& onMatch,
+                 const Cancel& cancel) const;
+
+        QList<ContentMatch> search(const PboPath& path, const QByteArray& content) const;
+
+        //throws if the entry could not be read or decompressed
+        static QByteArray readContent(const BinarySource* binarySource, const Cancel& cancel);
+
+    private:
+        QByteArray text_;
+        QRegularExpression regex_;
+        bool isRegex_;
+        bool caseSensitive_;
+
+        static void collectEntries(const PboNode* node, QList<Entry>& result);
+    };
+}
@@ -0,0 +1,199 @@
+#include "pbodiff.h"
+#include <QBuffer>
+#include <QHash>
+#include <QSet>
+#include <cstring>
+#include "io/diskaccessexception.h"
+#include "io/lzh/lzh.h"
+#include "util/log.h"
+
+#define LOG(...) LOGGER("model/PboDiff", __VA_ARGS__)
+
+namespace pboman3::model {
+    int PboDiff::run(const QString& fileA, const QString& fileB, std::ostream& output, std::ostream& errors) {
+        QList<Change> changes;
+        try {
+            changes = diff(fileA, fileB);
+        } catch (const AppException& ex) {
+            LOG(warning, "Could not compare the files:", fileA, fileB, ex)
+            errors << "Failed | " << ex.message().toStdString() << std::endl;
+            return 2;
+        }
+
+        for (const Change& change : changes) {
+            output << kindName(change.kind).toStdString() << " | " << change.subject.toStdString();
+            if (!change.details.isEmpty())
+                output << " | " << change.details.toStdString();
+            output << std::endl;
+        }
+
+        return changes.isEmpty() ? 0 : 1;
+    }
+
+    QList<PboDiff::Change> PboDiff::diff(const QString& fileA, const QString& fileB) {
+        PboFile pboA(fileA);
+        if (!pboA.open(QIODeviceBase::ReadOnly))
+            throw DiskAccessException("Can not access the file. Check if it is used by other processes.", fileA);
+        PboFile pboB(fileB);
+        if (!pboB.open(QIODeviceBase::ReadOnly))
+            throw DiskAccessException("Can not access the file. Check if it is used by other processes.", fileB);
+
+        const PboFileHeader headerA = PboHeaderReader::readFileHeader(&pboA);
+        const PboFileHeader headerB = PboHeaderReader::readFileHeader(&pboB);
+
+        QList<Change> changes;
+        diffHeaders(headerA, headerB, changes);
+
+        const QList<Entry> entriesA = readEntries(headerA);
+        const QList<Entry> entriesB = readEntries(headerB);
+
+        //the game treats the paths case-insensitively
+        QHash<QString, qsizetype> indexB;
+        indexB.reserve(entriesB.count());
+        for (qsizetype i = 0; i < entriesB.count(); i++)
+            indexB.insert(entriesB.at(i).entity->fileName().toLower(), i);
+
+        QList<bool> matchedB(entriesB.count(), false);
+        for (const Entry& a : entriesA) {
+            const auto it = indexB.constFind(a.entity->fileName().toLower());
+            if (it == indexB.cend()) {
+                changes.append(Change{Change::Kind::Removed, a.entity->fileName(), ""});
+                continue;
+            }
+
+            matchedB[*it] = true;
+            const Entry& b = entriesB.at(*it);
+            if (!sameData(&pboA, a, &pboB, b))
+                changes.append(Change{Change::Kind::Modified, a.entity->fileName(), ""});
+        }
+
+        for (qsizetype i = 0; i < entriesB.count(); i++) {
+            if (!matchedB.at(i))
+                changes.append(Change{Change::Kind::Added, entriesB.at(i).entity->fileName(), ""});
+        }
+
+        LOG(info, "Compared the files:", fileA, fileB, "Changes:", changes.count())
+        return changes;
+    }
+
+    QList<PboDiff::Entry> PboDiff::readEntries(const PboFileHeader& header) {
+        QList<Entry> entries;
+        entries.reserve(header.entries.count());
+        qint64 offset = header.dataBlockStart;
+        for (const QSharedPointer<PboNodeEntity>& entity : header.entries) {
+            entries.append(Entry{entity, offset});
+            offset += entity->dataSize();
+        }
+        return entries;
+    }
+
+    void PboDiff::diffHeaders(const PboFileHeader& a, const PboFileHeader& b, QList<Change>& changes) {
+        QHash<QString, QString> valuesB;
+        for (const QSharedPointer<PboHeaderEntity>& header : b.headers)
+            valuesB.insert(header->name, header->value);
+
+        QSet<QString> namesA;
+        for (const QSharedPointer<PboHeaderEntity>& header : a.headers) {
+            namesA.insert(header->name);
+            const auto it = valuesB.constFind(header->name);
+            if (it == valuesB.cend())
+                changes.append(Change{Change::Kind::HeaderRemoved, header->name, header->value});
+            else if (*it != header->value)
+                changes.append(Change{Change::Kind::HeaderChanged, header->name, header->value + " -> " + *it});
+        }
+
+        for (const QSharedPointer<PboHeaderEntity>& header : b.headers) {
+            if (!namesA.contains(header->name))
+                changes.append(Change{Change::Kind::HeaderAdded, header->name, header->value});
+        }
+    }
+
+    bool PboDiff::sameData(PboFile* fileA, const Entry& a, PboFile* fileB, const Entry& b) {
+        const PboNodeEntity& ea = *a.entity;
+        const PboNodeEntity& eb = *b.entity;
+
+        //some tools write 0 as the original size of the uncompressed entries
+        const qint64 sizeA = ea.isCompressed() ? ea.originalSize() : ea.dataSize();
+        const qint64 sizeB = eb.isCompressed() ? eb.originalSize() : eb.dataSize();
+        if (sizeA != sizeB)
+            return false;
+
+        const bool samePacking = ea.isCompressed() == eb.isCompressed() && ea.dataSize() == eb.dataSize();
+
+        //the same size and timestamp are trusted to mean the same content, the data are not read
+        if (samePacking && ea.timestamp() == eb.timestamp())
+            return true;
+
+        if (samePacking) {
+            if (sameStoredBytes(fileA, a, fileB, b))
+                return true;
+            if (!ea.isCompressed())
+                return false;
+            //a different compressor could have produced different bytes out of the same content
+        }
+
+        return readContent(fileA, a) == readContent(fileB, b);
+    }
+
+    bool PboDiff::sameStoredBytes(PboFile* fileA, const Entry& a, PboFile* fileB, const Entry& b) {
+        constexpr qint64 bufferSize = 256 * 1024;
+        QByteArray bufferA(bufferSize, Qt::Initialization::Uninitialized);
+        QByteArray bufferB(bufferSize, Qt::Initialization::Uninitialized);
+
+        if (!fileA->seek(a.offset))
+            throw DiskAccessException("For some reason could not read from the file.", fileA->fileName());
+        if (!fileB->seek(b.offset))
+            throw DiskAccessException("For some reason could not read from the file.", fileB->fileName());
+
+        qint64 remaining = a.entity->dataSize();
+        while (remaining > 0) {
+            const qint64 chunk = std::min(remaining, bufferSize);
+            if (fileA->read(bufferA.data(), chunk) != chunk)
+                throw DiskAccessException("For some reason could not read from the file.", fileA->fileName());
+            if (fileB->read(bufferB.data(), chunk) != chunk)
+                throw DiskAccessException("For some reason could not read from the file.", fileB->fileName());
+            if (memcmp(bufferA.constData(), bufferB.constData(), chunk) != 0)
+                return false;
+            remaining -= chunk;
+        }
+
+        return true;
+    }
+
+    QByteArray PboDiff::readContent(PboFile* file, const Entry& entry) {
+        if (!file->seek(entry.offset))
+            throw DiskAccessException("For some reason could not read from the file.", file->fileName());
+
+        if (!entry.entity->isCompressed()) {
+            QByteArray data = file->read(entry.entity->dataSize());
+            if (data.size() != entry.entity->dataSize())
+                throw DiskAccessException("For some reason could not read from the file.", file->fileName());
+            return data;
+        }
+
+        QByteArray data;
+        data.reserve(entry.entity->originalSize());
+        QBuffer buffer(&data);
+        buffer.open(QIODeviceBase::WriteOnly);
+        Lzh::decompress(file, &buffer, entry.entity->originalSize(), []() { return false; });
+        return data;
+    }
+
+    QString PboDiff::kindName(Change::Kind kind) {
+        switch (kind) {
+            case Change::Kind::Added:
+                return "Added";
+            case Change::Kind::Removed:
+                return "Removed";
+            case Change::Kind::Modified:
+                return "Modified";
+            case Change::Kind::HeaderAdded:
+                return "Header added";
+            case Change::Kind::HeaderRemoved:
+                return "Header removed";
+            case Change::Kind::HeaderChanged:
+                return "Header changed";
+        }
+        return "";
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <QList>
+#include <ostream>
+#include "io/pboheaderreader.h"
+
+namespace pboman3::model {
+    using namespace io;
+
+    //compares two PBOs without unpacking them
+    //the entry tables are matched by path first, the data are read only for the entries whose size or timestamp differ
+    //the stored bytes are compared as is when both sides use the same packing, decompressed otherwise
+    class PboDiff {
+    public:
+        struct Change {
+            enum class Kind {
+                Added,
+                Removed,
+                Modified,
+                HeaderAdded,
+                HeaderRemoved,
+                HeaderChanged
+            };
+
+            Kind kind;
+            QString subject;
+            QString details;
+        };
+
+        //prints a line per change, returns the process exit code as diff does: 0 - same, 1 - different, 2 - failure
+        static int run(const QString& fileA, const QString& fileB, std::ostream& output, std::ostream& errors);
+
+        //throws if any of the files could not be read or is not a PBO
+        static QList<Change> diff(const QString& fileA, const QString& fileB);
+
+    private:
+        struct Entry {
+            QSharedPointer<PboNodeEntity> entity;
+            qint64 offset;
+        };
+
+        static QList<Entry> readEntries(const PboFileHeader& header);
+
+        static void diffHeaders(const PboFileHeader& a, const PboFileHeader& b, QList<Change>& changes);
+
+        static bool sameData(PboFile* fileA, const Entry& a, PboFile* fileB, const Entry& b);
+
+        static bool sameStoredBytes(PboFile* fileA, const Entry& a, PboFile* fileB, const Entry& b);
+
+        static QByteArray readContent(PboFile* file, const Entry& entry);
+
+        static QString kindName(Change::Kind kind);
+    };
+}
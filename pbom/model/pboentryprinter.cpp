@@ -0,0 +1,57 @@
+#include "pboentryprinter.h"
+#include "io/bs/pbobinarysource.h"
+#include "io/diskaccessexception.h"
+#include "io/pboentryfilter.h"
+#include "io/pboheaderreader.h"
+#include "util/log.h"
+
+#define LOG(...) LOGGER("model/PboEntryPrinter", __VA_ARGS__)
+
+namespace pboman3::model {
+    using namespace io;
+
+    int PboEntryPrinter::run(const QString& file, const QString& entryPath, QIODevice* output, std::ostream& errors) {
+        try {
+            print(file, entryPath, output, []() { return false; });
+            return 0;
+        } catch (const AppException& ex) {
+            LOG(warning, "Could not print the entry:", entryPath, ex)
+            errors << "Failed | " << file.toStdString() << " | " << entryPath.toStdString()
+                << " | " << ex.message().toStdString() << std::endl;
+            return 1;
+        }
+    }
+
+    void PboEntryPrinter::print(const QString& file, const QString& entryPath, QIODevice* output, const Cancel& cancel) {
+        PboFile pbo(file);
+        if (!pbo.open(QIODeviceBase::ReadOnly))
+            throw DiskAccessException("Can not access the file. Check if it is used by other processes.", file);
+        const PboFileHeader header = PboHeaderReader::readFileHeader(&pbo);
+        pbo.close();
+
+        PboEntryFilter filter;
+        filter.addPath(entryPath);
+
+        qsizetype entryDataOffset = header.dataBlockStart;
+        for (const QSharedPointer<PboNodeEntity>& e : header.entries) {
+            if (filter.matches(e->makePath())) {
+                LOG(info, "Printing the entry:", *e)
+                const PboDataInfo dataInfo{
+                    e->originalSize(),
+                    e->dataSize(),
+                    entryDataOffset,
+                    e->timestamp(),
+                    e->packingMethod() == PboPackingMethod::Packed
+                };
+                const PboBinarySource source(file, dataInfo);
+                source.open();
+                source.writeToStream(output, cancel);
+                source.close();
+                return;
+            }
+            entryDataOffset += e->dataSize();
+        }
+
+        throw AppException("The PBO has no such entry");
+    }
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <QIODevice>
+#include <ostream>
+#include "util/util.h"
+
+namespace pboman3::model {
+    using namespace util;
+
+    //writes the contents of a single PBO entry to a stream, reading just the header and that entry's data
+    //nothing goes through the temp files, so the output starts as soon as the first chunk is decoded
+    class PboEntryPrinter {
+    public:
+        //returns the process exit code, 0 if the entry was printed
+        static int run(const QString& file, const QString& entryPath, QIODevice* output, std::ostream& errors);
+
+        //throws if the file could not be read, is not a PBO, has no such entry or the entry could not be decompressed
+        static void print(const QString& file, const QString& entryPath, QIODevice* output, const Cancel& cancel);
+    };
+}
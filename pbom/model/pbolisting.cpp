@@ -0,0 +1,114 @@
+#include "pbolisting.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QThread>
+#include "io/diskaccessexception.h"
+#include "util/executionpools.h"
+#include "util/orderedrun.h"
+#include "util/log.h"
+
+#define LOG(...) LOGGER("model/PboListing", __VA_ARGS__)
+
+namespace pboman3::model {
+    PboListing::PboListing(Format format, int jobs)
+        : format_(format),
+          jobs_(jobs > 0 ? jobs : QThread::idealThreadCount()) {
+    }
+
+    int PboListing::run(const QStringList& files, std::ostream& output, std::ostream& errors) const {
+        struct Listing {
+            QByteArray text;
+            QString error;
+        };
+
+        int exitCode = 0;
+        util::RunOrdered<Listing>(util::ExecutionPools::io(), jobs_, files.count(), [this, &files](qsizetype index) {
+            try {
+                return Listing{list(files.at(index)), ""};
+            } catch (const AppException& ex) {
+                LOG(warning, "Could not list the file:", files.at(index), ex)
+                return Listing{QByteArray(), ex.message()};
+            }
+        }, [&files, &output, &errors, &exitCode](qsizetype index, Listing& listing) {
+            if (listing.error.isEmpty()) {
+                output.write(listing.text.constData(), listing.text.size());
+            } else {
+                output.flush();
+                errors << "Failed | " << files.at(index).toStdString() << " | " << listing.error.toStdString() << std::endl;
+                exitCode = 1;
+            }
+        });
+        output.flush();
+
+        return exitCode;
+    }
+
+    QByteArray PboListing::list(const QString& file) const {
+        PboFile pbo(file);
+        if (!pbo.open(QIODeviceBase::ReadOnly))
+            throw DiskAccessException("Can not access the file. Check if it is used by other processes.", file);
+
+        const PboFileHeader header = PboHeaderReader::readFileHeader(&pbo);
+        return format_ == Format::Json ? formatJson(file, header) : formatText(file, header);
+    }
+
+    QByteArray PboListing::formatText(const QString& file, const PboFileHeader& header) {
+        const QByteArray fileBytes = file.toUtf8();
+        QByteArray text;
+        text.reserve(header.entries.count() * (fileBytes.size() + 64));
+
+        qint64 offset = header.dataBlockStart;
+        for (const QSharedPointer<PboNodeEntity>& entry : header.entries) {
+            text.append(fileBytes).append('\t')
+                .append(entry->fileName().toUtf8()).append('\t')
+                .append(packingMethodName(entry->packingMethod()).toLatin1()).append('\t')
+                .append(QByteArray::number(entry->originalSize())).append('\t')
+                .append(QByteArray::number(entry->dataSize())).append('\t')
+                .append(QByteArray::number(entry->timestamp())).append('\t')
+                .append(QByteArray::number(offset)).append('\n');
+            offset += entry->dataSize();
+        }
+        return text;
+    }
+
+    QByteArray PboListing::formatJson(const QString& file, const PboFileHeader& header) {
+        QJsonArray headers;
+        for (const QSharedPointer<PboHeaderEntity>& h : header.headers)
+            headers.append(QJsonObject{{"name", h->name}, {"value", h->value}});
+
+        QJsonArray entries;
+        qint64 offset = header.dataBlockStart;
+        for (const QSharedPointer<PboNodeEntity>& entry : header.entries) {
+            entries.append(QJsonObject{
+                {"path", entry->fileName()},
+                {"packing", packingMethodName(entry->packingMethod())},
+                {"originalSize", entry->originalSize()},
+                {"dataSize", entry->dataSize()},
+                {"timestamp", entry->timestamp()},
+                {"offset", offset}
+            });
+            offset += entry->dataSize();
+        }
+
+        const QJsonObject json{
+            {"file", file},
+            {"headers", headers},
+            {"entries", entries},
+            {"signature", QString(header.signature.toHex())}
+        };
+        return QJsonDocument(json).toJson(QJsonDocument::Compact).append('\n');
+    }
+
+    QString PboListing::packingMethodName(PboPackingMethod method) {
+        switch (method) {
+            case PboPackingMethod::Uncompressed:
+                return "uncompressed";
+            case PboPackingMethod::Packed:
+                return "packed";
+            case PboPackingMethod::Product:
+                return "product";
+        }
+        return QString::number(static_cast<qint32>(method), 16);
+    }
+}
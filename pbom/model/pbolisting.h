@@ -0,0 +1,40 @@
+#pragma once
+
+#include <QStringList>
+#include <ostream>
+#include "io/pboheaderreader.h"
+
+namespace pboman3::model {
+    using namespace io;
+
+    //prints the entries of the PBOs reading just their headers
+    //the PBOs are read in parallel but printed in the given order, each as soon as it and the ones before it are read
+    class PboListing {
+    public:
+        enum class Format {
+            //a tab-separated line per entry: pbo, path, packing, original size, data size, timestamp, offset
+            Text,
+            //a JSON object per line per PBO
+            Json
+        };
+
+        //jobs - the number of PBOs read at once, 0 means as many as the CPU cores
+        PboListing(Format format, int jobs);
+
+        //returns the process exit code, 0 if all the files were listed
+        int run(const QStringList& files, std::ostream& output, std::ostream& errors) const;
+
+        //throws if the file could not be read or is not a PBO
+        QByteArray list(const QString& file) const;
+
+    private:
+        Format format_;
+        int jobs_;
+
+        static QByteArray formatText(const QString& file, const PboFileHeader& header);
+
+        static QByteArray formatJson(const QString& file, const PboFileHeader& header);
+
+        static QString packingMethodName(PboPackingMethod method);
+    };
+}
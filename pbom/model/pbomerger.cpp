@@ -0,0 +1,107 @@
+#include "pbomerger.h"
+#include <QFileInfo>
+#include "domain/documentheaderstransaction.h"
+#include "domain/func.h"
+#include "io/documentreader.h"
+#include "io/documentwriter.h"
+#include "util/log.h"
+
+#define LOG(...) LOGGER("model/PboMerger", __VA_ARGS__)
+
+namespace pboman3::model {
+    using namespace io;
+
+    qsizetype PboMerger::merge(PboDocument* target, const PboDocument* source, ConflictResolution onConflict) {
+        assert(onConflict != ConflictResolution::Unset && "The conflict resolution must be set");
+
+        QList<const PboNode*> nodes;
+        collectFileNodes(source->root(), nodes);
+
+        qsizetype conflicts = 0;
+        for (const PboNode* node : nodes) {
+            const PboPath path = node->makePath();
+            PboNode* created;
+            if (IsPathConflict(target->root(), path)) {
+                LOG(debug, "The entry is in conflict:", path)
+                conflicts++;
+                if (onConflict == ConflictResolution::Skip)
+                    continue;
+                created = target->root()->createHierarchy(path, onConflict);
+            } else {
+                created = target->root()->createHierarchy(path);
+            }
+            //the source is shared, so it outlives the document it was read into
+            created->binarySource = node->binarySource;
+        }
+
+        mergeHeaders(target, source);
+
+        LOG(info, "Merged", nodes.count(), "entries with", conflicts, "conflicts")
+        return conflicts;
+    }
+
+    qsizetype PboMerger::merge(const QStringList& files, const QString& output, ConflictResolution onConflict,
+                               const Cancel& cancel) {
+        PboDocument document(QFileInfo(output).fileName());
+
+        qsizetype conflicts = 0;
+        for (const QString& file : files) {
+            LOG(info, "Reading the file:", file)
+            const DocumentReader reader(file);
+            const QSharedPointer<PboDocument> source = reader.read();
+            conflicts += merge(&document, source.get(), onConflict);
+            if (cancel())
+                return conflicts;
+        }
+
+        LOG(info, "Writing the merged file:", output)
+        DocumentWriter writer(output);
+        writer.write(&document, cancel);
+
+        return conflicts;
+    }
+
+    int PboMerger::run(const QStringList& files, const QString& output, ConflictResolution onConflict,
+                       std::ostream& out, std::ostream& errors) {
+        try {
+            const qsizetype conflicts = merge(files, output, onConflict, []() { return false; });
+            out << "Merged " << files.count() << " PBOs, " << conflicts << " entries in conflict | "
+                << output.toStdString() << std::endl;
+            return 0;
+        } catch (const AppException& ex) {
+            LOG(warning, "Could not merge the files:", files, ex)
+            errors << "Failed | " << output.toStdString() << " | " << ex.message().toStdString() << std::endl;
+            return 1;
+        }
+    }
+
+    void PboMerger::collectFileNodes(const PboNode* node, QList<const PboNode*>& result) {
+        for (const PboNode* child : *node) {
+            if (child->nodeType() == PboNodeType::File) {
+                result.append(child);
+            } else {
+                collectFileNodes(child, result);
+            }
+        }
+    }
+
+    void PboMerger::mergeHeaders(PboDocument* target, const PboDocument* source) {
+        const QSharedPointer<DocumentHeadersTransaction> tran = target->headers()->beginTransaction();
+        bool changed = false;
+        for (const DocumentHeader* header : *source->headers()) {
+            bool exists = false;
+            for (qsizetype i = 0; i < tran->count(); i++) {
+                if (tran->at(i)->name() == header->name()) {
+                    exists = true;
+                    break;
+                }
+            }
+            if (!exists) {
+                tran->add(header->name(), header->value());
+                changed = true;
+            }
+        }
+        if (changed)
+            tran->commit();
+    }
+}
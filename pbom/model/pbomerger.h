@@ -0,0 +1,33 @@
+#pragma once
+
+#include <QStringList>
+#include <ostream>
+#include "domain/conflictresolution.h"
+#include "domain/pbodocument.h"
+
+namespace pboman3::model {
+    using namespace domain;
+
+    //combines several PBOs into one: the trees are built from the headers alone
+    //and the stored bytes of every entry are copied as they are, nothing is decompressed or compressed again
+    class PboMerger {
+    public:
+        //adds the entries and the headers missing in the target, the headers already there are kept
+        //returns the number of the entries that were in conflict with the target
+        static qsizetype merge(PboDocument* target, const PboDocument* source, ConflictResolution onConflict);
+
+        //merges the files in the given order into the output; returns the number of the entries in conflict
+        //throws if any of the files could not be read or the output could not be written
+        static qsizetype merge(const QStringList& files, const QString& output, ConflictResolution onConflict,
+                               const Cancel& cancel);
+
+        //returns the process exit code
+        static int run(const QStringList& files, const QString& output, ConflictResolution onConflict,
+                       std::ostream& out, std::ostream& errors);
+
+    private:
+        static void collectFileNodes(const PboNode* node, QList<const PboNode*>& result);
+
+        static void mergeHeaders(PboDocument* target, const PboDocument* source);
+    };
+}
@@ -7,6 +7,7 @@
 #include "io/documentreader.h"
 #include "io/documentwriter.h"
 #include "exception.h"
+#include "pbomerger.h"
 #include "util/log.h"
 
 #define LOG(...) LOGGER("model/PboModel", __VA_ARGS__)
@@ -135,6 +136,23 @@ namespace pboman3::model {
         return conflicts;
     }
 
+    qsizetype PboModel::mergeFiles(const QStringList& paths, ConflictResolution onConflict) const {
+        if (!document_)
+            throw InvalidOperationException("The model is not initialized");
+
+        LOG(info, "Merging the files:", paths)
+
+        qsizetype total = 0;
+        for (const QString& path : paths) {
+            const DocumentReader reader(path);
+            const QSharedPointer<PboDocument> source = reader.read();
+            const qsizetype conflicts = PboMerger::merge(document_.get(), source.get(), onConflict);
+            LOG(info, "Merged the file:", path, "Conflicts:", conflicts)
+            total += conflicts;
+        }
+        return total;
+    }
+
     void PboModel::unpackNodesTo(const QDir& dest, const PboNode* rootNode,
                                       const QList<PboNode*>& childNodes,
                                       const Cancel& cancel) const {
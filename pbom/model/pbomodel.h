@@ -27,6 +27,10 @@ namespace pboman3::model {
 
         ConflictsParcel checkConflicts(const PboNode* parent, const QList<NodeDescriptor>& descriptors) const;
 
+        //adds the entries of the PBOs to the loaded document, copying their stored bytes on save
+        //returns the number of the entries that were in conflict with the document
+        qsizetype mergeFiles(const QStringList& paths, ConflictResolution onConflict) const;
+
         void unpackNodesTo(const QDir& dest, const PboNode* rootNode, const QList<PboNode*>& childNodes, const Cancel& cancel) const;
 
         PboDocument* document() const;
@@ -0,0 +1,64 @@
+#include "pborecompressor.h"
+#include <QFile>
+#include "io/diskaccessexception.h"
+#include "io/documentreader.h"
+#include "io/documentwriter.h"
+#include "io/bs/pbolzhbinarysource.h"
+#include "model/task/packconfiguration.h"
+#include "util/log.h"
+
+#define LOG(...) LOGGER("model/PboRecompressor", __VA_ARGS__)
+
+namespace pboman3::model {
+    using namespace io;
+    using namespace task;
+
+    int PboRecompressor::run(const QString& file, const QString& rulesFile, const QString& output,
+                             std::ostream& out, std::ostream& errors) {
+        try {
+            const qsizetype compressed = recompress(file, rulesFile, output, []() { return false; });
+            out << "Compressed " << compressed << " entries | " << output.toStdString() << std::endl;
+            return 0;
+        } catch (const AppException& ex) {
+            LOG(warning, "Could not recompress the file:", file, ex)
+            errors << "Failed | " << file.toStdString() << " | " << ex.message().toStdString() << std::endl;
+            return 1;
+        }
+    }
+
+    qsizetype PboRecompressor::recompress(const QString& file, const QString& rulesFile, const QString& output,
+                                          const Cancel& cancel) {
+        QFile rules(rulesFile);
+        if (!rules.open(QIODeviceBase::ReadOnly))
+            throw DiskAccessException("Could not read the file", rulesFile);
+        const PackOptions options = PackConfiguration::readPackOptions(rules.readAll());
+        rules.close();
+
+        LOG(info, "Reading the file:", file)
+        const DocumentReader reader(file);
+        const QSharedPointer<PboDocument> document = reader.read();
+
+        qsizetype compressed = 0;
+        for (PboNode* node : PackConfiguration::selectCompressed(document->root(), options)) {
+            //the entries already compressed are copied as they are, no point in decompressing them
+            const auto* bs = dynamic_cast<PboBinarySource*>(node->binarySource.get());
+            if (!bs || bs->isCompressed() || bs->getInfo().dataSize == 0)
+                continue;
+
+            node->binarySource = QSharedPointer<BinarySource>(new PboLzhBinarySource(bs->path(), bs->getInfo()));
+            node->binarySource->open();
+            compressed++;
+        }
+
+        LOG(info, "Entries to compress:", compressed)
+        if (compressed == 0 && output == file) {
+            LOG(info, "Nothing to compress - leave the file as it is")
+            return 0;
+        }
+
+        DocumentWriter writer(output);
+        writer.write(document.get(), cancel);
+
+        return compressed;
+    }
+}
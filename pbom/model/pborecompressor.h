@@ -0,0 +1,23 @@
+#pragma once
+
+#include <QString>
+#include <ostream>
+#include "util/util.h"
+
+namespace pboman3::model {
+    using namespace util;
+
+    //compresses the entries of an existing PBO the compression rules of a pbo.json select
+    //the entries are compressed in parallel right from their ranges in the PBO, the rest is copied as stored
+    class PboRecompressor {
+    public:
+        //output - the PBO to write, the same as the file to recompress it in place keeping the original as .bak
+        //returns the process exit code
+        static int run(const QString& file, const QString& rulesFile, const QString& output,
+                       std::ostream& out, std::ostream& errors);
+
+        //returns the number of the entries compressed; throws if the files could not be read or written
+        static qsizetype recompress(const QString& file, const QString& rulesFile, const QString& output,
+                                    const Cancel& cancel);
+    };
+}
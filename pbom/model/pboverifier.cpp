@@ -0,0 +1,145 @@
+#include "pboverifier.h"
+#include <QCryptographicHash>
+#include <QThread>
+#include "io/diskaccessexception.h"
+#include "io/lzh/lzh.h"
+#include "io/lzh/lzhdecompressionexception.h"
+#include "util/executionpools.h"
+#include "util/orderedrun.h"
+#include "util/log.h"
+
+#define LOG(...) LOGGER("model/PboVerifier", __VA_ARGS__)
+
+namespace pboman3::model {
+    namespace {
+        //discards whatever is written, so the entries are decoded just for their checksums
+        class NullDevice : public QIODevice {
+        public:
+            NullDevice() {
+                open(QIODeviceBase::WriteOnly | QIODeviceBase::Unbuffered);
+            }
+
+            bool isSequential() const override {
+                return true;
+            }
+
+        protected:
+            qint64 readData(char*, qint64) override {
+                return -1;
+            }
+
+            qint64 writeData(const char*, qint64 length) override {
+                return length;
+            }
+        };
+    }
+
+    PboVerifier::PboVerifier(int jobs)
+        : jobs_(jobs > 0 ? jobs : QThread::idealThreadCount()) {
+    }
+
+    int PboVerifier::run(const QStringList& files, std::ostream& output) const {
+        int exitCode = 0;
+        util::RunOrdered<QStringList>(util::ExecutionPools::io(), jobs_, files.count(), [this, &files](qsizetype index) {
+            try {
+                return verify(files.at(index));
+            } catch (const AppException& ex) {
+                LOG(warning, "Could not verify the file:", files.at(index), ex)
+                return QStringList{ex.message()};
+            }
+        }, [&files, &output, &exitCode](qsizetype index, QStringList& problems) {
+            const std::string file = files.at(index).toStdString();
+            if (problems.isEmpty()) {
+                output << "OK | " << file << std::endl;
+            } else {
+                for (const QString& problem : problems)
+                    output << "Failed | " << file << " | " << problem.toStdString() << std::endl;
+                exitCode = 1;
+            }
+        });
+
+        return exitCode;
+    }
+
+    QStringList PboVerifier::verify(const QString& file) const {
+        PboFile pbo(file);
+        if (!pbo.open(QIODeviceBase::ReadOnly))
+            throw DiskAccessException("Can not access the file. Check if it is used by other processes.", file);
+
+        const PboFileHeader header = PboHeaderReader::readFileHeader(&pbo);
+
+        if (const QString problem = checkBounds(header, pbo.size()); !problem.isEmpty())
+            return QStringList{problem}; //the other checks would read past the end of the file
+
+        qint64 dataBlockEnd = header.dataBlockStart;
+        for (const QSharedPointer<PboNodeEntity>& entry : header.entries)
+            dataBlockEnd += entry->dataSize();
+
+        QStringList problems;
+        if (const QString problem = checkSignature(&pbo, header, dataBlockEnd); !problem.isEmpty())
+            problems.append(problem);
+        problems.append(checkEntries(&pbo, header));
+
+        LOG(info, "Verified the file:", file, "Problems:", problems)
+        return problems;
+    }
+
+    QString PboVerifier::checkBounds(const PboFileHeader& header, qint64 fileSize) {
+        qint64 offset = header.dataBlockStart;
+        for (const QSharedPointer<PboNodeEntity>& entry : header.entries) {
+            if (entry->dataSize() < 0 || offset + entry->dataSize() > fileSize)
+                return "The entry data lie beyond the end of the file: " + entry->fileName();
+            offset += entry->dataSize();
+        }
+        return "";
+    }
+
+    QString PboVerifier::checkSignature(PboFile* file, const PboFileHeader& header, qint64 dataBlockEnd) {
+        if (header.signature.isEmpty())
+            return "The file has no signature";
+
+        const bool seek = file->seek(0);
+        assert(seek);
+
+        QCryptographicHash sha1(QCryptographicHash::Sha1);
+        QByteArray buffer(1024 * 1024, Qt::Initialization::Uninitialized);
+        qint64 remaining = dataBlockEnd;
+        while (remaining > 0) {
+            const qint64 read = file->read(buffer.data(), std::min(remaining, static_cast<qint64>(buffer.size())));
+            if (read <= 0)
+                throw DiskAccessException("For some reason could not read from the file.", file->fileName());
+            sha1.addData(buffer.constData(), read);
+            remaining -= read;
+        }
+
+        if (sha1.result() != header.signature)
+            return "The signature does not match the contents";
+        return "";
+    }
+
+    QStringList PboVerifier::checkEntries(PboFile* file, const PboFileHeader& header) {
+        QStringList problems;
+        NullDevice sink;
+        const util::Cancel noCancel = []() { return false; };
+
+        qint64 offset = header.dataBlockStart;
+        for (const QSharedPointer<PboNodeEntity>& entry : header.entries) {
+            //the entries marked as packed but of the same size are stored as is
+            if (entry->isCompressed()) {
+                const bool seek = file->seek(offset);
+                assert(seek);
+                try {
+                    Lzh::decompress(file, &sink, entry->originalSize(), noCancel);
+                    //a damaged entry might still decode fine by borrowing the bytes of the next one
+                    if (file->pos() != offset + entry->dataSize())
+                        problems.append("The entry data do not match the entry size: " + entry->fileName());
+                } catch (const LzhDecompressionException&) {
+                    problems.append("The entry could not be decompressed: " + entry->fileName());
+                }
+            }
+            offset += entry->dataSize();
+        }
+
+        return problems;
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <QStringList>
+#include <ostream>
+#include "io/pboheaderreader.h"
+
+namespace pboman3::model {
+    using namespace io;
+
+    //checks the PBOs for corruption without writing anything to the disk:
+    //the entries must fit in the file, the signature must match the SHA1 of the contents
+    //and every compressed entry must decode with a matching checksum
+    //the PBOs are checked in parallel but reported in the given order
+    class PboVerifier {
+    public:
+        //jobs - the number of PBOs checked at once, 0 means as many as the CPU cores
+        explicit PboVerifier(int jobs);
+
+        //prints a line per PBO, returns the process exit code, 0 if all the files are intact
+        int run(const QStringList& files, std::ostream& output) const;
+
+        //returns the problems found, empty if the file is intact; throws if the file could not be read
+        QStringList verify(const QString& file) const;
+
+    private:
+        int jobs_;
+
+        static QString checkBounds(const PboFileHeader& header, qint64 fileSize);
+
+        static QString checkSignature(PboFile* file, const PboFileHeader& header, qint64 dataBlockEnd);
+
+        static QStringList checkEntries(PboFile* file, const PboFileHeader& header);
+    };
+}
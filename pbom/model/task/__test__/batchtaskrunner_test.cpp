@@ -0,0 +1,104 @@
+#include "model/task/batchtaskrunner.h"
+#include <QAtomicInt>
+#include <sstream>
+#include <gtest/gtest.h>
+#include "exception.h"
+
+namespace pboman3::model::task::test {
+    class FakeTask : public Task {
+    public:
+        FakeTask(QAtomicInt* counter, QString message, bool raise, bool notice = false)
+            : counter_(counter),
+              message_(std::move(message)),
+              raise_(raise),
+              notice_(notice) {
+        }
+
+        void execute(const Cancel& cancel) override {
+            counter_->fetchAndAddRelaxed(1);
+            if (raise_)
+                throw InvalidOperationException("Task exception");
+            if (message_.isEmpty())
+                return;
+            if (notice_)
+                emit taskMessage(message_);
+            else
+                fail(message_);
+        }
+
+    private:
+        QAtomicInt* counter_;
+        QString message_;
+        bool raise_;
+        bool notice_;
+    };
+
+    class BatchTaskRunnerTest : public testing::TestWithParam<int> {
+    };
+
+    TEST_P(BatchTaskRunnerTest, Run_Executes_All_Tasks_And_Returns_Zero) {
+        QAtomicInt counter;
+        BatchTaskRunner runner(GetParam());
+        for (int i = 0; i < 10; i++)
+            runner.addTask(QSharedPointer<Task>(new FakeTask(&counter, "", false)), QString::number(i));
+
+        std::ostringstream output;
+        const int exitCode = runner.run(output);
+
+        ASSERT_EQ(exitCode, 0);
+        ASSERT_EQ(counter.loadRelaxed(), 10);
+        ASSERT_NE(output.str().find("Total: 10, succeeded: 10, failed: 0"), std::string::npos);
+    }
+
+    TEST_P(BatchTaskRunnerTest, Run_Reports_Failed_Tasks) {
+        QAtomicInt counter;
+        BatchTaskRunner runner(GetParam());
+        runner.addTask(QSharedPointer<Task>(new FakeTask(&counter, "", false)), "t1");
+        runner.addTask(QSharedPointer<Task>(new FakeTask(&counter, "Failure | Message", false)), "t2");
+        runner.addTask(QSharedPointer<Task>(new FakeTask(&counter, "", true)), "t3");
+
+        std::ostringstream output;
+        const int exitCode = runner.run(output);
+
+        ASSERT_EQ(exitCode, 1);
+        ASSERT_EQ(counter.loadRelaxed(), 3);
+
+        const std::string text = output.str();
+        ASSERT_NE(text.find("Done | t1\n"), std::string::npos);
+        ASSERT_NE(text.find("Failed | t2\n    Failure | Message\n"), std::string::npos);
+        ASSERT_NE(text.find("Failed | t3\n    Task exception\n"), std::string::npos);
+        ASSERT_NE(text.find("Total: 3, succeeded: 1, failed: 2"), std::string::npos);
+    }
+
+    TEST_P(BatchTaskRunnerTest, Run_Does_Not_Fail_Tasks_On_Notices) {
+        QAtomicInt counter;
+        BatchTaskRunner runner(GetParam());
+        runner.addTask(QSharedPointer<Task>(new FakeTask(&counter, "File already exists | e1.txt", false, true)),
+                       "t1");
+
+        std::ostringstream output;
+        const int exitCode = runner.run(output);
+
+        ASSERT_EQ(exitCode, 0);
+        ASSERT_NE(output.str().find("Done | t1\n    File already exists | e1.txt\n"), std::string::npos);
+        ASSERT_NE(output.str().find("Total: 1, succeeded: 1, failed: 0"), std::string::npos);
+    }
+
+    TEST_P(BatchTaskRunnerTest, Run_Prints_Stats_Of_Each_Task) {
+        QAtomicInt counter;
+        BatchTaskRunner runner(GetParam());
+        runner.setStatsFormat(BatchTaskRunner::StatsFormat::Json);
+        runner.addTask(QSharedPointer<Task>(new FakeTask(&counter, "", false)), "t1");
+        runner.addTask(QSharedPointer<Task>(new FakeTask(&counter, "", false)), "t2");
+
+        std::ostringstream output;
+        runner.run(output);
+
+        const std::string text = output.str();
+        ASSERT_NE(text.find("\"title\": \"t1\""), std::string::npos);
+        ASSERT_NE(text.find("\"title\": \"t2\""), std::string::npos);
+        ASSERT_NE(text.find("\"total\""), std::string::npos);
+    }
+
+    INSTANTIATE_TEST_SUITE_P(BatchTaskRunnerTest, BatchTaskRunnerTest, testing::Values(1, 4));
+}
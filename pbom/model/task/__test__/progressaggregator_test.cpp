@@ -0,0 +1,67 @@
+#include "model/task/progressaggregator.h"
+#include <QList>
+#include <QPair>
+#include <gtest/gtest.h>
+
+namespace pboman3::model::task::test {
+    TEST(ProgressAggregatorTest, Publish_Emits_Only_Changed_Slots) {
+        ProgressAggregator aggregator(3);
+        QList<QPair<qint32, qint32>> emitted;
+        QObject::connect(&aggregator, &ProgressAggregator::slotProgress, [&emitted](qint32 slot, qint32 progress) {
+            emitted.append(QPair(slot, progress));
+        });
+
+        aggregator.advance(0, 5);
+        aggregator.advance(0, 7);
+        aggregator.advance(2, 1);
+        aggregator.publish();
+
+        ASSERT_EQ(emitted.count(), 2);
+        ASSERT_EQ(emitted.at(0), QPair(0, 7));
+        ASSERT_EQ(emitted.at(1), QPair(2, 1));
+
+        emitted.clear();
+        aggregator.publish();
+        ASSERT_TRUE(emitted.isEmpty());
+    }
+
+    TEST(ProgressAggregatorTest, Advance_Does_Not_Go_Back) {
+        ProgressAggregator aggregator(1);
+        qint32 last = -1;
+        QObject::connect(&aggregator, &ProgressAggregator::slotProgress, [&last](qint32, qint32 progress) {
+            last = progress;
+        });
+
+        aggregator.advance(0, 10);
+        aggregator.advance(0, 4);
+        aggregator.publish();
+        ASSERT_EQ(last, 10);
+
+        aggregator.reset(0, 0);
+        aggregator.publish();
+        ASSERT_EQ(last, 0);
+    }
+
+    TEST(ProgressAggregatorTest, Publish_Emits_Overall_Progress_When_Changed) {
+        ProgressAggregator aggregator(1);
+        int count = 0;
+        qint64 lastProcessed = 0;
+        qint64 lastTotal = 0;
+        QObject::connect(&aggregator, &ProgressAggregator::overallProgress,
+                         [&](qint64 processed, qint64 total) {
+                             count++;
+                             lastProcessed = processed;
+                             lastTotal = total;
+                         });
+
+        aggregator.setTotal(100);
+        aggregator.addProcessed(30);
+        aggregator.addProcessed(20);
+        aggregator.publish();
+        aggregator.publish();
+
+        ASSERT_EQ(count, 1);
+        ASSERT_EQ(lastProcessed, 50);
+        ASSERT_EQ(lastTotal, 100);
+    }
+}
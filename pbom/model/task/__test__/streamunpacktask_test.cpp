@@ -0,0 +1,113 @@
+#include "model/task/streamunpacktask.h"
+#include <QBuffer>
+#include <QTemporaryDir>
+#include <gtest/gtest.h>
+#include "io/__test__/testpbobuilder.h"
+
+namespace pboman3::model::task::test {
+    class StreamUnpackTaskTest : public testing::Test {
+    protected:
+        QTemporaryDir source_;
+        QTemporaryDir output_;
+        QByteArray pbo_;
+        QByteArray packed_;
+        QByteArray raw_;
+        QStringList messages_;
+
+        void SetUp() override {
+            for (int i = 0; i < 300; i++)
+                packed_.append(QByteArray::number(i % 7)).append(" some repeating text\r\n");
+            raw_ = QByteArray(100, 5);
+
+            const QString pboPath = io::test::TestPboBuilder(source_.path())
+                                    .addEntry("f1/e1.txt", packed_, true)
+                                    .addEntry("e2.bin", raw_)
+                                    .write("file.pbo");
+
+            QFile pbo(pboPath);
+            pbo.open(QIODeviceBase::ReadOnly);
+            pbo_ = pbo.readAll();
+            pbo.close();
+        }
+
+        void unpack(const io::PboEntryFilter& filter = io::PboEntryFilter()) {
+            QBuffer stream(&pbo_);
+            stream.open(QIODeviceBase::ReadOnly);
+
+            StreamUnpackTask task(&stream, "stdin", output_.path(), filter);
+            QObject::connect(&task, &Task::taskMessage, [this](const QString& message) {
+                messages_.append(message);
+            });
+            task.execute([]() { return false; });
+        }
+
+        QByteArray readOutput(const QString& path) const {
+            QFile file(output_.filePath(path));
+            if (!file.open(QIODeviceBase::ReadOnly))
+                return QByteArray();
+            return file.readAll();
+        }
+
+        io::PboFileHeader readHeader() const {
+            QByteArray pbo(pbo_);
+            QBuffer stream(&pbo);
+            stream.open(QIODeviceBase::ReadOnly);
+            io::PboStreamReader reader(&stream);
+            return reader.readHeader();
+        }
+    };
+
+    TEST_F(StreamUnpackTaskTest, Execute_Unpacks_All_Entries) {
+        unpack();
+
+        ASSERT_TRUE(messages_.isEmpty());
+        ASSERT_EQ(readOutput("f1/e1.txt"), packed_);
+        ASSERT_EQ(readOutput("e2.bin"), raw_);
+    }
+
+    TEST_F(StreamUnpackTaskTest, Execute_Skips_Entries_Not_Matching_Filter) {
+        io::PboEntryFilter filter;
+        filter.addInclude("*.bin");
+
+        unpack(filter);
+
+        ASSERT_TRUE(messages_.isEmpty());
+        ASSERT_FALSE(QFile::exists(output_.filePath("f1/e1.txt")));
+        ASSERT_EQ(readOutput("e2.bin"), raw_);
+    }
+
+    TEST_F(StreamUnpackTaskTest, Execute_Reports_Signature_Mismatch) {
+        pbo_[pbo_.size() - 30] = static_cast<char>(pbo_.at(pbo_.size() - 30) + 1);
+
+        unpack();
+
+        ASSERT_EQ(messages_.count(), 1);
+        ASSERT_EQ(messages_.at(0), "The PBO signature does not match its contents | stdin");
+    }
+
+    TEST_F(StreamUnpackTaskTest, Execute_Writes_Raw_Bytes_If_Decompression_Fails) {
+        //the compressed entry goes first as the folders go before the files
+        const io::PboFileHeader header = readHeader();
+        const qsizetype offset = header.dataBlockStart;
+        pbo_[offset + 10] = 0x7f;
+
+        unpack();
+
+        ASSERT_EQ(readOutput("f1/e1.txt"), pbo_.mid(offset, header.entries.at(0)->dataSize()));
+        ASSERT_EQ(readOutput("e2.bin"), raw_);
+    }
+
+    TEST_F(StreamUnpackTaskTest, Execute_Reports_Existing_Files) {
+        QFile existing(output_.filePath("e2.bin"));
+        existing.open(QIODeviceBase::WriteOnly);
+        existing.write("existing");
+        existing.close();
+
+        unpack();
+
+        ASSERT_EQ(messages_.count(), 1);
+        ASSERT_EQ(messages_.at(0), "File already exists | " + output_.filePath("e2.bin"));
+        ASSERT_EQ(readOutput("e2.bin"), "existing");
+        ASSERT_EQ(readOutput("f1/e1.txt"), packed_);
+    }
+}
@@ -0,0 +1,189 @@
+#include "batchtaskrunner.h"
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSemaphore>
+#include <QThread>
+#include <algorithm>
+#include <iomanip>
+#include "exception.h"
+#include "util/executionpools.h"
+#include "util/log.h"
+#include "util/tracer.h"
+
+#define LOG(...) LOGGER("model/task/BatchTaskRunner", __VA_ARGS__)
+
+namespace pboman3::model::task {
+    BatchTaskRunner::BatchTaskRunner(int jobs)
+        : jobs_(jobs > 0 ? jobs : QThread::idealThreadCount()),
+          statsFormat_(StatsFormat::None) {
+    }
+
+    void BatchTaskRunner::addTask(const QSharedPointer<Task>& task, const QString& title) {
+        reports_.append(TaskReport{task, title, QStringList(), false, 0, nullptr});
+    }
+
+    void BatchTaskRunner::setStatsFormat(StatsFormat format) {
+        statsFormat_ = format;
+    }
+
+    int BatchTaskRunner::run(std::ostream& output) {
+        //all the threads are used even if there are fewer tasks, the extra ones help with the subtasks
+        const int numThreads = jobs_;
+        LOG(info, "Running", reports_.count(), "tasks using", numThreads, "threads")
+
+        if (numThreads <= 1 || reports_.isEmpty()) {
+            for (TaskReport& report : reports_)
+                runTask(report, output);
+        } else {
+            //the largest task started last would define how long the whole batch takes
+            for (TaskReport& report : reports_)
+                report.cost = report.task->estimateCost();
+            std::stable_sort(reports_.begin(), reports_.end(), [](const TaskReport& a, const TaskReport& b) {
+                return a.cost > b.cost;
+            });
+
+            nextReport_.storeRelaxed(0);
+            pendingReports_.storeRelaxed(static_cast<int>(reports_.count()));
+
+            //the workers share the io pool with the rest of the app, like the runners of the task window do,
+            //so the pool can not be waited for as a whole, each worker reports its own completion
+            QSemaphore workersDone;
+            for (int i = 0; i < numThreads - 1; i++) {
+                util::ExecutionPools::io()->start([this, &output, &workersDone]() {
+                    runWorker(output);
+                    workersDone.release();
+                });
+            }
+            runWorker(output);
+            workersDone.acquire(numThreads - 1);
+        }
+
+        printSummary(output);
+
+        if (statsFormat_ == StatsFormat::Table)
+            printStatsTable(output);
+        else if (statsFormat_ == StatsFormat::Json)
+            printStatsJson(output);
+
+        const bool failed = std::any_of(reports_.begin(), reports_.end(), [](const TaskReport& report) {
+            return report.failed;
+        });
+        return failed ? 1 : 0;
+    }
+
+    void BatchTaskRunner::runWorker(std::ostream& output) {
+        int index = nextReport_.fetchAndAddRelaxed(1);
+        while (index < reports_.count()) {
+            TaskReport& report = reports_[index];
+            report.task->setSubtaskQueue(&subtasks_);
+            runTask(report, output);
+            if (!pendingReports_.deref()) {
+                //the last task is done, nothing is going to be published anymore
+                subtasks_.close();
+            }
+            index = nextReport_.fetchAndAddRelaxed(1);
+        }
+
+        //no tasks left to start, help the ones still running to finish
+        while (pendingReports_.loadAcquire() > 0) {
+            if (!subtasks_.help())
+                subtasks_.waitForWork();
+        }
+    }
+
+    void BatchTaskRunner::runTask(TaskReport& report, std::ostream& output) {
+        //the messages are printed along with the task, but only the failures fail it, not the notices
+        QObject::connect(report.task.get(), &Task::taskMessage, [&report](const QString& message) {
+            report.messages.append(message);
+        });
+        QObject::connect(report.task.get(), &Task::taskFailed, [&report]() {
+            report.failed = true;
+        });
+
+        if (statsFormat_ != StatsFormat::None) {
+            report.stats = QSharedPointer<TaskStats>::create();
+            report.task->setStats(report.stats.get());
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        try {
+            TRACE_SCOPE("task", "task", report.title)
+            report.task->execute([] { return false; });
+        } catch (const AppException& ex) {
+            LOG(warning, "Task", report.title, "failed with exception:", ex)
+            report.messages.append(ex.message());
+            report.failed = true;
+        } catch (const std::exception& ex) {
+            LOG(warning, "Task", report.title, "failed with exception:", QString(ex.what()))
+            report.messages.append(ex.what());
+            report.failed = true;
+        }
+
+        if (report.stats)
+            report.stats->setWallNs(timer.nsecsElapsed());
+
+        //the task holds the whole PBO document, release it as soon as possible
+        report.task.clear();
+
+        printReport(report, output);
+    }
+
+    void BatchTaskRunner::printReport(const TaskReport& report, std::ostream& output) {
+        QString text = (report.failed ? "Failed | " : "Done | ") + report.title + "\n";
+        for (const QString& message : report.messages)
+            text.append("    ").append(message).append("\n");
+
+        QMutexLocker locker(&outputMutex_);
+        output << text.toStdString() << std::flush;
+    }
+
+    void BatchTaskRunner::printSummary(std::ostream& output) const {
+        const auto failed = std::count_if(reports_.begin(), reports_.end(), [](const TaskReport& report) {
+            return report.failed;
+        });
+        output << "Total: " << reports_.count() << ", succeeded: " << reports_.count() - failed
+            << ", failed: " << failed << std::endl;
+    }
+
+    void BatchTaskRunner::printStatsTable(std::ostream& output) const {
+        const auto printRow = [&output](const PhaseStats& phase) {
+            output << "    " << std::left << std::setw(18) << phase.name.toStdString() << std::right << std::fixed
+                << std::setprecision(1)
+                << std::setw(12) << static_cast<double>(phase.wallNs) / 1000000
+                << std::setw(12) << static_cast<double>(phase.cpuNs) / 1000000
+                << std::setw(16) << phase.bytesIn
+                << std::setw(16) << phase.bytesOut
+                << std::setprecision(3) << std::setw(8) << phase.ratio() << std::endl;
+        };
+
+        for (const TaskReport& report : reports_) {
+            if (!report.stats)
+                continue;
+            output << "Stats | " << report.title.toStdString() << std::endl;
+            output << "    " << std::left << std::setw(18) << "Phase" << std::right
+                << std::setw(12) << "Wall ms" << std::setw(12) << "CPU ms"
+                << std::setw(16) << "Bytes in" << std::setw(16) << "Bytes out" << std::setw(8) << "Ratio" << std::endl;
+            for (const PhaseStats& phase : report.stats->phases())
+                printRow(phase);
+            printRow(report.stats->total());
+        }
+    }
+
+    void BatchTaskRunner::printStatsJson(std::ostream& output) const {
+        QJsonArray tasks;
+        for (const TaskReport& report : reports_) {
+            if (!report.stats)
+                continue;
+            QJsonObject task = report.stats->toJson();
+            task.insert("title", report.title);
+            task.insert("failed", report.failed);
+            tasks.append(task);
+        }
+
+        QJsonObject root;
+        root.insert("tasks", tasks);
+        output << QJsonDocument(root).toJson().toStdString() << std::flush;
+    }
+}
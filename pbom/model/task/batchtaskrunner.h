@@ -0,0 +1,63 @@
+#pragma once
+
+#include <QAtomicInt>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QStringList>
+#include <ostream>
+#include "task.h"
+
+namespace pboman3::model::task {
+    //runs the tasks of a console batch on the io pool
+    //the messages of a task are held back until it finishes, so the output of the tasks does not interleave
+    class BatchTaskRunner {
+    public:
+        enum class StatsFormat {
+            None,
+            Table,
+            Json
+        };
+
+        //jobs - the max number of tasks running at once, 0 means as many as the CPU cores
+        //it does not cap the threads, a task can still run its own work in parallel
+        explicit BatchTaskRunner(int jobs);
+
+        void addTask(const QSharedPointer<Task>& task, const QString& title);
+
+        //when set, the phases of each task are timed and printed after the summary
+        void setStatsFormat(StatsFormat format);
+
+        //returns the process exit code, 0 if all the tasks succeeded
+        int run(std::ostream& output);
+
+    private:
+        struct TaskReport {
+            QSharedPointer<Task> task;
+            QString title;
+            QStringList messages;
+            bool failed;
+            qint64 cost;
+            QSharedPointer<TaskStats> stats;
+        };
+
+        int jobs_;
+        StatsFormat statsFormat_;
+        QList<TaskReport> reports_;
+        QMutex outputMutex_;
+        QAtomicInt nextReport_;
+        QAtomicInt pendingReports_;
+        SubtaskQueue subtasks_;
+
+        void runWorker(std::ostream& output);
+
+        void runTask(TaskReport& report, std::ostream& output);
+
+        void printReport(const TaskReport& report, std::ostream& output);
+
+        void printSummary(std::ostream& output) const;
+
+        void printStatsTable(std::ostream& output) const;
+
+        void printStatsJson(std::ostream& output) const;
+    };
+}
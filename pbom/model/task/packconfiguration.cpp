@@ -79,6 +79,24 @@ namespace pboman3::model::task {
         }
     }
 
+    QList<PboNode*> PackConfiguration::selectCompressed(PboNode* root, const PackOptions& options) {
+        const CompressionRules rules = buildCompressionRules(options);
+        QList<PboNode*> result;
+        selectCompressed(root, rules, result);
+        return result;
+    }
+
+    void PackConfiguration::selectCompressed(PboNode* node, const CompressionRules& rules, QList<PboNode*>& result) {
+        if (node->nodeType() == PboNodeType::File) {
+            if (shouldCompress(node, rules))
+                result.append(node);
+        } else {
+            for (PboNode* child : *node) {
+                selectCompressed(child, rules, result);
+            }
+        }
+    }
+
     bool PackConfiguration::shouldCompress(const PboNode* node, const CompressionRules& rules) {
         const QString path = node->makePath().toString();
 
@@ -125,7 +143,10 @@ namespace pboman3::model::task {
     }
 
     PackOptions PackConfiguration::readPackOptions(const PboNode* node) {
-        const QByteArray data = readNodeContent(node);
+        return readPackOptions(readNodeContent(node));
+    }
+
+    PackOptions PackConfiguration::readPackOptions(const QByteArray& data) {
         QJsonParseError err;
         const QJsonDocument json = QJsonDocument::fromJson(data, &err);
         if (json.isNull()) {
@@ -23,6 +23,12 @@ namespace pboman3::model::task {
 
         void apply() const;
 
+        //throws JsonStructureException if the data is not a valid pbo.json
+        static PackOptions readPackOptions(const QByteArray& data);
+
+        //the files of the tree the compression rules of the options select
+        static QList<PboNode*> selectCompressed(PboNode* root, const PackOptions& options);
+
     private:
         struct CompressionRules;
 
@@ -32,6 +38,8 @@ namespace pboman3::model::task {
 
         void applyDocumentCompressionRules(PboNode* node, const CompressionRules& rules) const;
 
+        static void selectCompressed(PboNode* node, const CompressionRules& rules, QList<PboNode*>& result);
+
         static bool shouldCompress(const PboNode* node, const CompressionRules& rules);
 
         static CompressionRules buildCompressionRules(const PackOptions& options);
@@ -1,8 +1,10 @@
 #include "packtask.h"
+#include <QDirIterator>
 
 #include "packconfiguration.h"
 #include "io/diskaccessexception.h"
 #include "io/documentwriter.h"
+#include "io/streamdocumentwriter.h"
 #include "util/log.h"
 
 #define LOG(...) LOGGER("model/task/PackTask", __VA_ARGS__)
@@ -12,7 +14,13 @@ namespace pboman3::model::task {
 
     PackTask::PackTask(QString folder, QString outputDir)
         : folder_(std::move(folder)),
-          outputDir_(std::move(outputDir)) {
+          outputDir_(std::move(outputDir)),
+          output_(nullptr) {
+    }
+
+    PackTask::PackTask(QString folder, QIODevice* output)
+        : folder_(std::move(folder)),
+          output_(output) {
     }
 
     void PackTask::execute(const Cancel& cancel) {
@@ -22,23 +30,27 @@ namespace pboman3::model::task {
         const QDir folder(folder_);
         const QString pboFile = QDir(outputDir_).filePath(folder.dirName()).append(".pbo");
         LOG(info, "The pbo file name:", pboFile)
-        if (QFileInfo(pboFile).exists()) {
+        if (!output_ && QFileInfo(pboFile).exists()) {
             LOG(info, "The pbo file already exists")
-            emit taskMessage("Failure | File already exists | " + pboFile);
+            fail("Failure | File already exists | " + pboFile);
             return;
         }
 
         emit taskThinking(folder.absolutePath());
 
         PboDocument document("root");
-        const qint32 filesCount = collectDir(folder, folder, *document.root(), cancel);
+        qint32 filesCount;
+        {
+            ScopedPhase phase(stats_, "scan");
+            filesCount = collectDir(folder, folder, *document.root(), cancel);
+        }
 
         if (cancel())
             return;
 
         if (filesCount == 0) {
             LOG(info, "The Folder was empty")
-            emit taskMessage("Failure | The folder is empty | " + folder.absolutePath());
+            fail("Failure | The folder is empty | " + folder.absolutePath());
             return;
         }
 
@@ -46,14 +58,20 @@ namespace pboman3::model::task {
             const task::PackConfiguration packConfiguration(&document);
             packConfiguration.apply();
         } catch (const JsonStructureException& ex) {
-            emit taskMessage("Failure | pbo.json malformed | " + ex.message());
+            fail("Failure | pbo.json malformed | " + ex.message());
             return;
         } catch (const task::PrefixEncodingException& ex) {
-            emit taskMessage("Failure | " + ex.message() + " | The file has unsupported encoding");
+            fail("Failure | " + ex.message() + " | The file has unsupported encoding");
+            return;
+        }
+
+        if (output_) {
+            writeToStream(&document, folder, filesCount, cancel);
             return;
         }
 
         DocumentWriter writer(pboFile);
+        writer.setStats(stats_);
 
         //it is tricky to display real PBO pack progress as the process consists of four independent steps.
         //1. Scan the source folder and grab files. It might take time we can't estimate at all. So just show "indeterminate" progress indicator.
@@ -98,8 +116,40 @@ namespace pboman3::model::task {
             LOG(info, "Pack complete")
         } catch (const DiskAccessException& ex) {
             LOG(warning, "Task failed with exception:", ex)
-            emit taskMessage("Failure | " + ex.message() + " | " + folder.absolutePath());
+            fail("Failure | " + ex.message() + " | " + folder.absolutePath());
+        }
+    }
+
+    void PackTask::writeToStream(PboDocument* document, const QDir& folder, qint32 filesCount, const Cancel& cancel) {
+        StreamDocumentWriter writer(output_);
+        writer.setStats(stats_);
+
+        //the compression runs first and can not report its progress, so the progress is the count of entries written
+        emit taskInitialized(folder.absolutePath(), 0, filesCount);
+
+        qint32 progress = 0;
+        std::function onEntryWritten = [this, &progress]() {
+            emit taskProgress(++progress);
+        };
+        writer.setOnEntryWritten(&onEntryWritten);
+
+        try {
+            writer.write(document, cancel);
+            LOG(info, "Pack complete")
+        } catch (const DiskAccessException& ex) {
+            LOG(warning, "Task failed with exception:", ex)
+            fail("Failure | " + ex.message() + " | " + folder.absolutePath());
+        }
+    }
+
+    qint64 PackTask::estimateCost() const {
+        qint64 cost = 0;
+        QDirIterator it(folder_, QDir::Files | QDir::Hidden | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            it.next();
+            cost += it.fileInfo().size();
         }
+        return cost;
     }
 
     QDebug operator<<(QDebug debug, const PackTask& task) {
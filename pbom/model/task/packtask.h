@@ -1,6 +1,7 @@
 #pragma once
 
 #include <QDir>
+#include <QIODevice>
 #include "task.h"
 #include "model/interactionparcel.h"
 
@@ -11,13 +12,21 @@ namespace pboman3::model::task {
     public:
         PackTask(QString folder, QString outputDir);
 
+        //writes the PBO to the device instead of a file in the output dir, e.g. to stdout
+        PackTask(QString folder, QIODevice* output);
+
         void execute(const Cancel& cancel) override;
 
+        qint64 estimateCost() const override;
+
         friend QDebug operator<<(QDebug debug, const PackTask& task);
 
     private:
         const QString folder_;
         const QString outputDir_;
+        QIODevice* const output_;
+
+        void writeToStream(PboDocument* document, const QDir& folder, qint32 filesCount, const Cancel& cancel);
 
         qint32 collectDir(const QDir& dirEntry, const QDir& rootDir, PboNode& rootNode, const Cancel& cancel) const;
 
@@ -0,0 +1,55 @@
+#include "progressaggregator.h"
+
+namespace pboman3::model::task {
+    ProgressAggregator::ProgressAggregator(qint32 numSlots, int intervalMs)
+        : numSlots_(numSlots),
+          slots_(new Slot[numSlots]),
+          publishedProcessed_(-1) {
+        timer_.setInterval(intervalMs);
+        connect(&timer_, &QTimer::timeout, this, &ProgressAggregator::publish);
+    }
+
+    void ProgressAggregator::reset(qint32 slot, qint32 progress) {
+        slots_[slot].progress.storeRelaxed(progress);
+        slots_[slot].changed.storeRelease(1);
+    }
+
+    void ProgressAggregator::advance(qint32 slot, qint32 progress) {
+        //the subtasks of one task might report out of order, the progress never goes back
+        QAtomicInt& current = slots_[slot].progress;
+        int value = current.loadRelaxed();
+        while (value < progress && !current.testAndSetOrdered(value, progress, value)) {
+        }
+        slots_[slot].changed.storeRelease(1);
+    }
+
+    void ProgressAggregator::setTotal(qint64 total) {
+        total_.storeRelease(total);
+    }
+
+    void ProgressAggregator::addProcessed(qint64 processed) {
+        processed_.fetchAndAddRelaxed(processed);
+    }
+
+    void ProgressAggregator::start() {
+        timer_.start();
+    }
+
+    void ProgressAggregator::stop() {
+        timer_.stop();
+        publish();
+    }
+
+    void ProgressAggregator::publish() {
+        for (qint32 i = 0; i < numSlots_; i++) {
+            if (slots_[i].changed.fetchAndStoreAcquire(0))
+                emit slotProgress(i, slots_[i].progress.loadRelaxed());
+        }
+
+        const qint64 processed = processed_.loadAcquire();
+        if (processed != publishedProcessed_) {
+            publishedProcessed_ = processed;
+            emit overallProgress(processed, total_.loadAcquire());
+        }
+    }
+}
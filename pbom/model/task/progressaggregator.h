@@ -0,0 +1,51 @@
+#pragma once
+
+#include <QAtomicInt>
+#include <QObject>
+#include <QTimer>
+#include <memory>
+
+namespace pboman3::model::task {
+    //the workers store their progress here and the aggregator publishes it at a fixed rate,
+    //so that the tasks with many tiny files do not flood the event loop with the signals
+    class ProgressAggregator : public QObject {
+    Q_OBJECT
+
+    public:
+        ProgressAggregator(qint32 numSlots, int intervalMs = 100);
+
+        //the methods below are safe to call from any thread
+        void reset(qint32 slot, qint32 progress);
+
+        void advance(qint32 slot, qint32 progress);
+
+        void setTotal(qint64 total);
+
+        void addProcessed(qint64 processed);
+
+        //the methods below must be called on the thread the aggregator belongs to
+        void start();
+
+        void stop();
+
+        void publish();
+
+    signals:
+        void slotProgress(qint32 slot, qint32 progress);
+
+        void overallProgress(qint64 processed, qint64 total);
+
+    private:
+        struct Slot {
+            QAtomicInt progress;
+            QAtomicInt changed;
+        };
+
+        qint32 numSlots_;
+        std::unique_ptr<Slot[]> slots_;
+        QAtomicInteger<qint64> total_;
+        QAtomicInteger<qint64> processed_;
+        qint64 publishedProcessed_;
+        QTimer timer_;
+    };
+}
@@ -0,0 +1,186 @@
+#include "streamunpacktask.h"
+#include <QBuffer>
+#include <QFile>
+#include "extractconfiguration.h"
+#include "packoptions.h"
+#include "io/bs/pbobinarysource.h"
+#include "io/diskaccessexception.h"
+#include "io/lzh/lzh.h"
+#include "io/lzh/lzhdecompressionexception.h"
+#include "io/pbofileformatexception.h"
+#include "util/log.h"
+#include "util/tracer.h"
+
+#define LOG(...) LOGGER("model/task/StreamUnpackTask", __VA_ARGS__)
+
+namespace pboman3::model::task {
+    using namespace io;
+
+    StreamUnpackTask::StreamUnpackTask(QIODevice* source, QString name, const QString& outputDir,
+                                       io::PboEntryFilter filter)
+        : source_(source),
+          name_(std::move(name)),
+          outputDir_(outputDir),
+          filter_(std::move(filter)) {
+    }
+
+    void StreamUnpackTask::execute(const Cancel& cancel) {
+        LOG(info, "PBO stream: ", name_)
+        LOG(info, "Output dir: ", outputDir_.absolutePath())
+
+        PboStreamReader reader(source_);
+        try {
+            PboFileHeader header;
+            {
+                ScopedPhase phase(stats_, "read header");
+                header = reader.readHeader();
+            }
+
+            QList<PboNode*> nodes;
+            const QSharedPointer<PboDocument> document = makeDocument(header, nodes);
+            const qint32 selectedCount = static_cast<qint32>(nodes.count() - nodes.count(nullptr));
+            emit taskInitialized(name_, 0, selectedCount);
+
+            const NodeFileSystem fileSystem(outputDir_);
+            qint32 progress = 0;
+            qint64 dataBytes = 0;
+            qint64 originalBytes = 0;
+            {
+                ScopedPhase phase(stats_, "extract");
+                for (qsizetype i = 0; i < header.entries.count() && !cancel(); i++) {
+                    const PboNodeEntity& entry = *header.entries.at(i);
+                    dataBytes += entry.dataSize();
+                    if (nodes.at(i)) {
+                        originalBytes += entry.packingMethod() == PboPackingMethod::Packed
+                                             ? entry.originalSize()
+                                             : entry.dataSize();
+                        unpackEntry(reader, entry, nodes.at(i), fileSystem, cancel);
+                        emit taskProgress(++progress);
+                    } else {
+                        reader.skipData(entry.dataSize(), cancel);
+                    }
+                }
+                phase.addBytes(dataBytes, originalBytes);
+            }
+            if (stats_)
+                stats_->setBytes(header.dataBlockStart + dataBytes, originalBytes);
+
+            if (cancel()) {
+                LOG(info, "Cancel - return")
+                return;
+            }
+
+            QByteArray signature;
+            if (!reader.verifySignature(&signature)) {
+                LOG(warning, "The signature did not match the contents")
+                fail("The PBO signature does not match its contents | " + name_);
+                return;
+            }
+            document->setSignature(signature);
+
+            //a partial extraction is not meant to be packed back, so it gets no pack config
+            if (filter_.isEmpty())
+                extractPboConfig(*document);
+        } catch (const PboFileFormatException& ex) {
+            LOG(warning, "Got error while reading the stream:", ex)
+            fail(ex.message() + " | " + name_);
+            return;
+        }
+
+        LOG(info, "Unpack complete")
+    }
+
+    QDebug operator<<(QDebug debug, const StreamUnpackTask& task) {
+        return debug << "StreamUnpackTask(Name=" << task.name_ << ", OutputDir=" << task.outputDir_ << ")";
+    }
+
+    QSharedPointer<PboDocument> StreamUnpackTask::makeDocument(const PboFileHeader& header,
+                                                               QList<PboNode*>& nodes) const {
+        QList<QSharedPointer<DocumentHeader>> headers;
+        headers.reserve(header.headers.count());
+        for (const QSharedPointer<PboHeaderEntity>& h : header.headers)
+            headers.append(QSharedPointer<DocumentHeader>(new DocumentHeader(DocumentHeader::InternalData{h->name, h->value})));
+
+        QSharedPointer<PboDocument> document(new PboDocument(name_, std::move(headers), QByteArray()));
+
+        nodes.reserve(header.entries.count());
+        qsizetype entryDataOffset = header.dataBlockStart;
+        for (const QSharedPointer<PboNodeEntity>& e : header.entries) {
+            const PboPath path = e->makePath();
+            if (filter_.matches(path)) {
+                PboNode* node = document->root()->createHierarchy(path);
+                const PboDataInfo dataInfo{
+                    e->originalSize(),
+                    e->dataSize(),
+                    entryDataOffset,
+                    e->timestamp(),
+                    e->packingMethod() == PboPackingMethod::Packed
+                };
+                //never opened, the data come from the stream; tells the pack config which entries were compressed
+                node->binarySource = QSharedPointer<PboBinarySource>(new PboBinarySource(name_, dataInfo));
+                nodes.append(node);
+            } else {
+                nodes.append(nullptr);
+            }
+            entryDataOffset += e->dataSize();
+        }
+
+        return document;
+    }
+
+    void StreamUnpackTask::unpackEntry(PboStreamReader& reader, const PboNodeEntity& entry, const PboNode* node,
+                                       const NodeFileSystem& fileSystem, const Cancel& cancel) {
+        LOG(debug, "Unpack the entry", entry)
+        TRACE_SCOPE("unpack", "write", node->title())
+
+        QString filePath;
+        try {
+            filePath = fileSystem.allocatePath(node);
+        } catch (const DiskAccessException& ex) {
+            LOG(warning, ex)
+            //remove the "." symbol from the end
+            fail(ex.message().left(ex.message().length() - 1) + " | " + ex.file());
+            reader.skipData(entry.dataSize(), cancel);
+            return;
+        }
+
+        QFile file(filePath);
+        if (!file.open(QIODeviceBase::WriteOnly | QIODeviceBase::NewOnly)) {
+            if (file.exists()) {
+                LOG(info, "File already exists:", file.fileName())
+                emit taskMessage("File already exists | " + file.fileName());
+                reader.skipData(entry.dataSize(), cancel);
+                return;
+            }
+            LOG(warning, "Can not access the file:", file.fileName())
+            fail("Could not write to the file | " + file.fileName());
+            reader.skipData(entry.dataSize(), cancel);
+            return;
+        }
+
+        if (entry.packingMethod() == PboPackingMethod::Packed) {
+            //the decoder looks back at its own output only, but needs the size of the input, so the entry is buffered
+            QByteArray packed = reader.readData(entry.dataSize());
+            QBuffer source(&packed);
+            source.open(QIODeviceBase::ReadOnly);
+            try {
+                TRACE_SCOPE("unpack", "decompress")
+                Lzh::decompress(&source, &file, entry.originalSize(), cancel);
+            } catch (const LzhDecompressionException&) {
+                LOG(info, "Could not decompress, writing the raw bytes:", entry)
+                file.resize(0);
+                file.write(packed);
+            }
+        } else {
+            reader.readData(&file, entry.dataSize(), cancel);
+        }
+
+        file.close();
+    }
+
+    void StreamUnpackTask::extractPboConfig(const PboDocument& document) {
+        const PackOptions options = ExtractConfiguration::extractFrom(document);
+        LOG(info, "Extracted the PBO pack config, Options=", options)
+        ExtractConfiguration::saveTo(options, outputDir_);
+    }
+}
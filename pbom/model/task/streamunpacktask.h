@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QDir>
+#include <QIODevice>
+#include "task.h"
+#include "domain/pbodocument.h"
+#include "io/bb/nodefilesystem.h"
+#include "io/pboentryfilter.h"
+#include "io/pbostreamreader.h"
+
+namespace pboman3::model::task {
+    using namespace domain;
+
+    //unpacks a PBO read strictly forward from a sequential device, e.g. stdin, in a single pass
+    //the entries are extracted as their bytes arrive and the signature is verified at the end
+    //the entries go right into the output dir as there is no PBO file name to make a folder of
+    class StreamUnpackTask : public Task {
+    public:
+        StreamUnpackTask(QIODevice* source, QString name, const QString& outputDir,
+                         io::PboEntryFilter filter = io::PboEntryFilter());
+
+        void execute(const Cancel& cancel) override;
+
+        friend QDebug operator <<(QDebug debug, const StreamUnpackTask& task);
+
+    private:
+        QIODevice* const source_;
+        const QString name_;
+        const QDir outputDir_;
+        const io::PboEntryFilter filter_;
+
+        QSharedPointer<PboDocument> makeDocument(const io::PboFileHeader& header, QList<PboNode*>& nodes) const;
+
+        void unpackEntry(io::PboStreamReader& reader, const io::PboNodeEntity& entry, const PboNode* node,
+                         const io::NodeFileSystem& fileSystem, const Cancel& cancel);
+
+        void extractPboConfig(const PboDocument& document);
+    };
+}
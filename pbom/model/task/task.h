@@ -1,6 +1,8 @@
 #pragma once
 
 #include <QObject>
+#include "util/subtaskqueue.h"
+#include "util/taskstats.h"
 #include "util/util.h"
 
 namespace pboman3::model::task {
@@ -12,6 +14,21 @@ namespace pboman3::model::task {
     public:
         virtual void execute(const Cancel& cancel) = 0;
 
+        //a cheap up-front estimate of the bytes the task is going to process, used for scheduling and progress
+        virtual qint64 estimateCost() const {
+            return 0;
+        }
+
+        //when set, the task publishes the parts of its work to the queue for the idle threads to take over
+        void setSubtaskQueue(SubtaskQueue* subtasks) {
+            subtasks_ = subtasks;
+        }
+
+        //when set, the task records the time and the bytes of its phases
+        void setStats(TaskStats* stats) {
+            stats_ = stats;
+        }
+
     signals:
         void taskThinking(const QString& text);
 
@@ -19,6 +36,19 @@ namespace pboman3::model::task {
 
         void taskProgress(qint32 progress);
 
+        //a notice, the task still succeeds unless it also emits taskFailed
         void taskMessage(const QString& message);
+
+        void taskFailed();
+
+    protected:
+        SubtaskQueue* subtasks_ = nullptr;
+        TaskStats* stats_ = nullptr;
+
+        //reports a message which makes the whole task count as failed
+        void fail(const QString& message) {
+            emit taskMessage(message);
+            emit taskFailed();
+        }
     };
 }
@@ -2,17 +2,53 @@
 #include <QThread>
 #include <QMutexLocker>
 #include <QThreadPool>
+#include <algorithm>
 #include "exception.h"
+#include "util/executionpools.h"
 #include "util/log.h"
+#include "util/tracer.h"
 
 #define LOG(...) LOGGER("model/task/TaskWindowModel", __VA_ARGS__)
 
 namespace pboman3::model::task {
+    TaskWindowModel::TaskWindowModel()
+        : numThreads_(QThread::idealThreadCount()),
+          progress_(numThreads_) {
+        connect(&progress_, &ProgressAggregator::slotProgress, this, &TaskWindowModel::threadProgress);
+        connect(&progress_, &ProgressAggregator::overallProgress, this, &TaskWindowModel::overallProgress);
+    }
+
     void TaskWindowModel::start() {
-        const int numThreads = std::min(QThread::idealThreadCount(), static_cast<int>(tasks_.count()));
-        for (int i = 0; i < numThreads; i++) {
-            QThreadPool::globalInstance()->start(new TaskRunnable(this, i));
+        progress_.start();
+        activeRunners_.storeRelaxed(numThreads_);
+
+        //estimating the costs touches the disk, so it must not happen on the UI thread
+        ExecutionPools::io()->start([this]() {
+            schedule();
+
+            //the threads left without a task of their own help the running tasks with their subtasks
+            for (int i = 0; i < numThreads_; i++) {
+                ExecutionPools::io()->start(new TaskRunnable(this, i));
+            }
+        });
+    }
+
+    void TaskWindowModel::schedule() {
+        QMutexLocker locker(&mutex_);
+
+        for (const QSharedPointer<Task>& task : tasks_) {
+            const qint64 cost = task->estimateCost();
+            costs_.insert(task.get(), cost);
+            totalCost_ += cost;
         }
+        progress_.setTotal(totalCost_);
+
+        //the largest task started last would define how long the whole batch takes
+        std::stable_sort(tasks_.begin(), tasks_.end(), [this](const QSharedPointer<Task>& a, const QSharedPointer<Task>& b) {
+            return costs_.value(a.get()) > costs_.value(b.get());
+        });
+
+        LOG(info, "Scheduled", tasks_.count(), "tasks of", totalCost_, "bytes in total")
     }
 
     void TaskWindowModel::stop() {
@@ -30,9 +66,14 @@ namespace pboman3::model::task {
             return nullptr;
 
         QSharedPointer<Task> task = tasks_.takeFirst();
+        runningTasks_.ref();
         return task;
     }
 
+    bool TaskWindowModel::hasRunningTasks() const {
+        return runningTasks_.loadAcquire() > 0;
+    }
+
     bool TaskWindowModel::isCancelled() const {
         return stopped_.loadAcquire() > 0;
     }
@@ -44,32 +85,51 @@ namespace pboman3::model::task {
     }
 
     void TaskWindowModel::TaskRunnable::run() {
-        emit model_->threadStarted(threadId_);
-
         auto cancel = [this]() {
             return model_->isCancelled();
         };
 
         QSharedPointer<Task> task = model_->pickNextTask();
+        const bool hasTasks = task != nullptr;
+        if (hasTasks)
+            emit model_->threadStarted(threadId_);
 
         while (task != nullptr) {
-            if (model_->isCancelled()) break;
+            if (model_->isCancelled()) {
+                model_->runningTasks_.deref();
+                break;
+            }
 
             connect(task.get(), &Task::taskThinking, [this](const QString& text) {
                 emit model_->threadThinking(threadId_, text);
             });
+            //the task progress is converted into the share of its estimated cost
+            TaskCost taskCost{model_->costs_.value(task.get()), 0, 0, 0};
             connect(task.get(), &Task::taskInitialized,
-                    [this](const QString& text, qint32 minProgress, qint32 maxProgress) {
+                    [this, &taskCost](const QString& text, qint32 minProgress, qint32 maxProgress) {
+                        taskCost.minProgress = minProgress;
+                        taskCost.maxProgress = maxProgress;
+                        model_->progress_.reset(threadId_, minProgress);
                         emit model_->threadInitialized(threadId_, text, minProgress, maxProgress);
                     });
-            connect(task.get(), &Task::taskProgress, [this](qint32 progress) {
-                emit model_->threadProgress(threadId_, progress);
+            connect(task.get(), &Task::taskProgress, [this, &taskCost](qint32 progress) {
+                if (taskCost.maxProgress > taskCost.minProgress) {
+                    const qint64 processed = static_cast<qint64>(static_cast<double>(taskCost.cost)
+                        * (progress - taskCost.minProgress) / (taskCost.maxProgress - taskCost.minProgress));
+                    model_->progress_.addProcessed(processed - taskCost.processed);
+                    taskCost.processed = processed;
+                }
+                //the aggregator publishes the latest value at its own pace
+                model_->progress_.advance(threadId_, progress);
             });
             connect(task.get(), &Task::taskMessage, [this](const QString& message) {
                 emit model_->threadMessage(threadId_, message);
             });
 
+            task->setSubtaskQueue(&model_->subtasks_);
+
             try {
+                TRACE_SCOPE("task", "task")
                 task->execute(cancel);
             } catch (const AppException& ex) {
                 LOG(warning, "Task", task, "failed with exception:", ex)
@@ -78,9 +138,26 @@ namespace pboman3::model::task {
                 LOG(warning, "Task", task, "failed with exception:", QString(ex.what()))
                 emit model_->threadMessage(threadId_, ex.what());
             }
+            //a task might have failed or reported its progress partially, count it as done anyway
+            model_->progress_.addProcessed(taskCost.cost - taskCost.processed);
+            model_->runningTasks_.deref();
             task = model_->pickNextTask();
         }
 
-        emit model_->threadCompleted(threadId_);
+        if (hasTasks)
+            emit model_->threadCompleted(threadId_);
+
+        while (model_->hasRunningTasks()) {
+            if (!model_->subtasks_.help())
+                model_->subtasks_.waitForWork(50);
+        }
+
+        finish();
+    }
+
+    void TaskWindowModel::TaskRunnable::finish() const {
+        //the last runner publishes the final numbers, the aggregator timer belongs to the UI thread
+        if (!model_->activeRunners_.deref())
+            QMetaObject::invokeMethod(&model_->progress_, &ProgressAggregator::stop, Qt::QueuedConnection);
     }
 }
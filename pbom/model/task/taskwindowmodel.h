@@ -1,9 +1,11 @@
 #pragma once
 
 #include <QAtomicInt>
+#include <QHash>
 #include <QMutex>
 #include <QRunnable>
 #include <QSharedPointer>
+#include "progressaggregator.h"
 #include "task.h"
 
 namespace pboman3::model::task {
@@ -13,6 +15,8 @@ namespace pboman3::model::task {
     Q_OBJECT
 
     public:
+        TaskWindowModel();
+
         void start();
 
         void stop();
@@ -30,6 +34,9 @@ namespace pboman3::model::task {
 
         void threadMessage(ThreadId threadId, const QString& message);
 
+        //the progress of all the tasks together, measured in the estimated bytes
+        void overallProgress(qint64 processed, qint64 total);
+
     protected:
         void addTask(const QSharedPointer<Task>& task);
 
@@ -37,9 +44,20 @@ namespace pboman3::model::task {
         QMutex mutex_;
         QList<QSharedPointer<Task>> tasks_;
         QAtomicInt stopped_;
+        QAtomicInt runningTasks_;
+        SubtaskQueue subtasks_;
+        QHash<const Task*, qint64> costs_;
+        qint64 totalCost_ = 0;
+        qint32 numThreads_;
+        QAtomicInt activeRunners_;
+        ProgressAggregator progress_;
+
+        void schedule();
 
         QSharedPointer<Task> pickNextTask();
 
+        bool hasRunningTasks() const;
+
         bool isCancelled() const;
 
         class TaskRunnable : public QRunnable {
@@ -49,6 +67,15 @@ namespace pboman3::model::task {
             void run() override;
 
         private:
+            struct TaskCost {
+                qint64 cost;
+                qint64 processed;
+                qint32 minProgress;
+                qint32 maxProgress;
+            };
+
+            void finish() const;
+
             TaskWindowModel* model_;
             ThreadId threadId_;
         };
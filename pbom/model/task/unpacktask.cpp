@@ -12,6 +12,7 @@
 #include "io/diskaccessexception.h"
 #include "io/documentreader.h"
 #include "io/pbofileformatexception.h"
+#include "util/executionpools.h"
 #include "util/log.h"
 
 #define LOG(...) LOGGER("model/task/UnpackTask", __VA_ARGS__)
@@ -19,9 +20,10 @@
 namespace pboman3::model::task {
     using namespace io;
 
-    UnpackTask::UnpackTask(QString pboPath, const QString& outputDir)
+    UnpackTask::UnpackTask(QString pboPath, const QString& outputDir, io::PboEntryFilter filter)
         : pboPath_(std::move(pboPath)),
-          outputDir_(outputDir) {
+          outputDir_(outputDir),
+          filter_(std::move(filter)) {
     }
 
     void UnpackTask::execute(const Cancel& cancel) {
@@ -29,8 +31,11 @@ namespace pboman3::model::task {
         LOG(info, "Output dir: ", outputDir_.absolutePath())
 
         QSharedPointer<PboDocument> document;
-        if (!tryReadPboHeader(&document))
-            return;
+        {
+            ScopedPhase phase(stats_, "read header");
+            if (!tryReadPboHeader(&document))
+                return;
+        }
         QDir pboDir;
         if (!tryCreatePboDir(&pboDir))
             return;
@@ -41,7 +46,11 @@ namespace pboman3::model::task {
         emit taskInitialized(pboPath_, startProgress, endProgress);
 
         std::function onError = [this](const QString& error) {
-            emit taskMessage(error);
+            fail(error);
+        };
+
+        std::function onWarning = [this](const QString& warning) {
+            emit taskMessage(warning);
         };
 
         int progress = startProgress;
@@ -52,19 +61,37 @@ namespace pboman3::model::task {
 
         UnpackTaskBackend be(pboDir);
         be.setOnError(&onError);
+        be.setOnWarning(&onWarning);
         be.setOnProgress(&onProgress);
+        be.setStats(stats_);
+        if (subtasks_)
+            be.setSubtaskQueue(subtasks_);
+        else
+            be.setThreadCount(util::ExecutionPools::io()->maxThreadCount());
 
         QList<PboNode*> childNodes;
         childNodes.reserve(document->root()->count());
         for (PboNode* node : *document->root())
             childNodes.append(node);
         be.unpackSync(document->root(), childNodes, cancel);
+        if (stats_) {
+            qint64 originalBytes = 0;
+            countOriginalBytes(*document->root(), originalBytes);
+            stats_->setBytes(QFileInfo(pboPath_).size(), originalBytes);
+        }
 
-        extractPboConfig(*document, pboDir);
+        //a partial extraction is not meant to be packed back, so it gets no pack config
+        if (filter_.isEmpty())
+            extractPboConfig(*document, pboDir);
 
         LOG(info, "Unpack complete")
     }
 
+    qint64 UnpackTask::estimateCost() const {
+        //the data block makes up nearly the whole PBO, reading the header just for the estimate does not pay off
+        return QFileInfo(pboPath_).size();
+    }
+
     QDebug operator<<(QDebug debug, const UnpackTask& task) {
         return debug << "UnpackTask(PboPath=" << task.pboPath_ << ", OutputDir=" << task.outputDir_ << ")";
     }
@@ -72,26 +99,39 @@ namespace pboman3::model::task {
     bool UnpackTask::tryReadPboHeader(QSharedPointer<PboDocument>* document) {
         try {
             const DocumentReader reader(pboPath_);
-            *document = reader.read();
+            *document = reader.read(filter_);
             LOG(debug, "The document:", *document)
             return true;
         } catch (const DiskAccessException& ex) {
             LOG(warning, "Got error while opening the file:", ex)
-            emit taskMessage("Can not read the file | " + pboPath_);
+            fail("Can not read the file | " + pboPath_);
             return false;
         } catch (const PboFileFormatException& ex) {
             LOG(warning, "Got error while reading the file document:", ex)
-            emit taskMessage("The file is not a PBO | " + pboPath_);
+            fail("The file is not a PBO | " + pboPath_);
             return false;
         }
     }
 
+    void UnpackTask::countOriginalBytes(const PboNode& node, qint64& originalBytes) {
+        for (const PboNode* child : node) {
+            if (child->nodeType() == PboNodeType::File) {
+                if (const auto* source = dynamic_cast<const PboBinarySource*>(child->binarySource.get())) {
+                    const PboDataInfo& info = source->getInfo();
+                    originalBytes += info.compressed ? info.originalSize : info.dataSize;
+                }
+            } else {
+                countOriginalBytes(*child, originalBytes);
+            }
+        }
+    }
+
     bool UnpackTask::tryCreatePboDir(QDir* dir) {
         const QString fileNameWithoutExt = GetFileNameWithoutExtension(QFileInfo(pboPath_).fileName());
         const QString absPath = outputDir_.absoluteFilePath(fileNameWithoutExt);
         if (!outputDir_.exists(fileNameWithoutExt) && !outputDir_.mkdir(fileNameWithoutExt)) {
             LOG(warning, "Could not create the directory:", absPath)
-            emit taskMessage("Could not create the directory | " + absPath);
+            fail("Could not create the directory | " + absPath);
         }
         LOG(info, "PBO output dir:", absPath)
         *dir = QDir(absPath);
@@ -107,7 +147,7 @@ namespace pboman3::model::task {
         while (it != last) {
             if (!local.exists(*it) && !local.mkdir(*it)) {
                 LOG(warning, "Could not create the directory:", local.absolutePath())
-                emit taskMessage("Could not create the directory | " + local.absolutePath());
+                fail("Could not create the directory | " + local.absolutePath());
                 return false;
             }
             local.cd(*it);
@@ -3,26 +3,32 @@
 #include <QDir>
 #include "task.h"
 #include "domain/pbodocument.h"
+#include "io/pboentryfilter.h"
 
 namespace pboman3::model::task {
     using namespace domain;
 
     class UnpackTask : public Task {
     public:
-        UnpackTask(QString pboPath, const QString& outputDir);
+        UnpackTask(QString pboPath, const QString& outputDir, io::PboEntryFilter filter = io::PboEntryFilter());
 
         void execute(const Cancel& cancel) override;
 
+        qint64 estimateCost() const override;
+
         friend QDebug operator <<(QDebug debug, const UnpackTask& task);
 
     private:
         const QString pboPath_;
         const QDir outputDir_;
+        const io::PboEntryFilter filter_;
 
         bool tryReadPboHeader(QSharedPointer<PboDocument>* document);
 
         bool tryCreatePboDir(QDir* dir);
 
+        static void countOriginalBytes(const PboNode& node, qint64& originalBytes);
+
         bool tryCreateEntryDir(const QDir& pboDir, const QSharedPointer<PboNode>& entry);
 
         void extractPboConfig(const PboDocument& document, const QDir& dir);
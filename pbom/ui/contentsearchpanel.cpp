@@ -0,0 +1,120 @@
+#include "contentsearchpanel.h"
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QVBoxLayout>
+#include "util/log.h"
+
+#define LOG(...) LOGGER("ui/ContentSearchPanel", __VA_ARGS__)
+
+namespace pboman3::ui {
+    ContentSearchPanel::ContentSearchPanel(QWidget* parent)
+        : QDockWidget("Find in contents", parent),
+          pattern_(new QLineEdit),
+          regex_(new QCheckBox("Re&gex")),
+          caseSensitive_(new QCheckBox("Match &case")),
+          button_(new QPushButton("&Find")),
+          matches_(new QTreeWidget),
+          matchCount_(0),
+          limitReached_(false) {
+        setObjectName("contentSearchPanel");
+        setAllowedAreas(Qt::BottomDockWidgetArea | Qt::RightDockWidgetArea);
+
+        pattern_->setPlaceholderText("Text to find in the entries");
+        pattern_->setClearButtonEnabled(true);
+
+        matches_->setColumnCount(3);
+        matches_->setHeaderLabels({"Entry", "Line", "Text"});
+        matches_->setRootIsDecorated(false);
+        matches_->setUniformRowHeights(true);
+        matches_->header()->setSectionResizeMode(0, QHeaderView::ResizeToContents);
+        matches_->header()->setSectionResizeMode(1, QHeaderView::ResizeToContents);
+
+        auto* options = new QHBoxLayout;
+        options->addWidget(pattern_, 1);
+        options->addWidget(regex_);
+        options->addWidget(caseSensitive_);
+        options->addWidget(button_);
+
+        auto* layout = new QVBoxLayout;
+        layout->setContentsMargins(4, 4, 4, 4);
+        layout->addLayout(options);
+        layout->addWidget(matches_, 1);
+
+        auto* content = new QWidget(this);
+        content->setLayout(layout); //ownership transferred!
+        setWidget(content);
+
+        connect(button_, &QPushButton::clicked, this, &ContentSearchPanel::onSearchClick);
+        connect(pattern_, &QLineEdit::returnPressed, this, &ContentSearchPanel::onSearchClick);
+        connect(matches_, &QTreeWidget::itemActivated, this, &ContentSearchPanel::onMatchActivated);
+    }
+
+    void ContentSearchPanel::startEditing() {
+        show();
+        raise();
+        pattern_->setFocus();
+        pattern_->selectAll();
+    }
+
+    void ContentSearchPanel::setSearching(bool searching) {
+        pattern_->setEnabled(!searching);
+        regex_->setEnabled(!searching);
+        caseSensitive_->setEnabled(!searching);
+        button_->setEnabled(!searching);
+    }
+
+    void ContentSearchPanel::clearMatches() {
+        matches_->clear();
+        matchCount_ = 0;
+        limitReached_ = false;
+    }
+
+    bool ContentSearchPanel::addMatches(const QList<ContentMatch>& matches) {
+        if (limitReached_)
+            return false;
+
+        const qsizetype count = std::min(matches.count(), maxMatches - matchCount_);
+        QList<QTreeWidgetItem*> items;
+        items.reserve(count + 1);
+        for (qsizetype i = 0; i < count; i++) {
+            const ContentMatch& match = matches.at(i);
+            auto* item = new QTreeWidgetItem;
+            item->setText(0, match.path.toString());
+            item->setText(1, QString::number(match.line));
+            item->setText(2, match.text);
+            item->setTextAlignment(1, Qt::AlignRight);
+            items.append(item);
+        }
+        matchCount_ += count;
+
+        QTreeWidgetItem* limitItem = nullptr;
+        if (count < matches.count()) {
+            LOG(info, "The search has reached the limit of", maxMatches, "matches")
+            limitReached_ = true;
+            limitItem = new QTreeWidgetItem;
+            limitItem->setText(0, QString("Too many matches, only the first %1 are shown").arg(maxMatches));
+            limitItem->setFlags(Qt::NoItemFlags);
+            items.append(limitItem);
+        }
+
+        matches_->addTopLevelItems(items); //ownership transferred!
+        if (limitItem)
+            limitItem->setFirstColumnSpanned(true);
+        return !limitReached_;
+    }
+
+    void ContentSearchPanel::onSearchClick() {
+        if (pattern_->text().isEmpty())
+            return;
+
+        LOG(info, "User requested the search:", pattern_->text())
+        emit searchRequested(pattern_->text(), regex_->isChecked(), caseSensitive_->isChecked());
+    }
+
+    void ContentSearchPanel::onMatchActivated(const QTreeWidgetItem* item) {
+        if (!(item->flags() & Qt::ItemIsEnabled))
+            return;
+        //the path rather than the node is kept, as the node may be gone by the time the match is clicked
+        emit matchActivated(PboPath(item->text(0)));
+    }
+}
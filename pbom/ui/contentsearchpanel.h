@@ -0,0 +1,49 @@
+#pragma once
+
+#include <QCheckBox>
+#include <QDockWidget>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QTreeWidget>
+#include "model/contentsearch.h"
+
+namespace pboman3::ui {
+    using namespace model;
+
+    //the text to find in the contents of the entries and the lines it was found on
+    class ContentSearchPanel : public QDockWidget {
+    Q_OBJECT
+    public:
+        ContentSearchPanel(QWidget* parent = nullptr);
+
+        void startEditing();
+
+        void setSearching(bool searching);
+
+        void clearMatches();
+
+        //adds the matches in one go, returns false once the limit is reached and no more matches are taken
+        bool addMatches(const QList<ContentMatch>& matches);
+
+    signals:
+        void searchRequested(const QString& pattern, bool regex, bool caseSensitive);
+
+        void matchActivated(const PboPath& path);
+
+    private:
+        QLineEdit* pattern_;
+        QCheckBox* regex_;
+        QCheckBox* caseSensitive_;
+        QPushButton* button_;
+        QTreeWidget* matches_;
+        qsizetype matchCount_;
+        bool limitReached_;
+
+        //a common word would otherwise fill the tree with hundreds of thousands of rows
+        static constexpr qsizetype maxMatches = 1000;
+
+        void onSearchClick();
+
+        void onMatchActivated(const QTreeWidgetItem* item);
+    };
+}
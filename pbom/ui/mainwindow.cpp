@@ -9,13 +9,16 @@
 #include "closedialog.h"
 #include "errordialog.h"
 #include "headersdialog.h"
+#include "mergedialog.h"
 #include "signaturedialog.h"
 #include "updatesdialog.h"
 #include "ui_mainwindow.h"
 #include "io/diskaccessexception.h"
 #include "io/pbofileformatexception.h"
+#include "model/contentsearch.h"
 #include "model/pbomodel.h"
 #include "treewidget/treewidget.h"
+#include "util/executionpools.h"
 #include "util/log.h"
 
 #define LOG(...) LOGGER("ui/MainWindow", __VA_ARGS__)
@@ -25,9 +28,13 @@ namespace pboman3::ui {
         : QMainWindow(parent),
           ui_(new Ui::MainWindow),
           model_(model),
+          searchPanel_(new ContentSearchPanel(this)),
           hasChanges_(false) {
         ui_->setupUi(this);
 
+        addDockWidget(Qt::BottomDockWidgetArea, searchPanel_);
+        searchPanel_->hide();
+
         ui_->treeWidget->setContextMenuPolicy(Qt::ContextMenuPolicy::CustomContextMenu);
         ui_->treeWidget->setWidgetModel(model_);
 
@@ -44,7 +51,7 @@ namespace pboman3::ui {
         if (model_->isLoaded())
             unloadFile();
 
-        const QFuture<int> future = QtConcurrent::run([this, &fileName](QPromise<int>& promise) {
+        const QFuture<int> future = QtConcurrent::run(util::ExecutionPools::io(), [this, &fileName](QPromise<int>& promise) {
             LOG(info, "Loading the file:", fileName)
             model_->loadFile(fileName);
             promise.addResult(0);
@@ -94,6 +101,9 @@ namespace pboman3::ui {
     void MainWindow::setupConnections() {
         connect(&loadWatcher_, &QFutureWatcher<int>::finished, this, &MainWindow::loadComplete);
         connect(&saveWatcher_, &QFutureWatcher<int>::finished, this, &MainWindow::saveComplete);
+        connect(&searchWatcher_, &QFutureWatcher<ContentMatch>::resultsReadyAt, this,
+                &MainWindow::contentSearchResultsReady);
+        connect(&searchWatcher_, &QFutureWatcher<ContentMatch>::finished, this, &MainWindow::contentSearchComplete);
 
         connect(ui_->treeWidget, &TreeWidget::backgroundOpStarted, this, [this](QFuture<void> f) {
             ui_->treeWidget->setEnabled(false);
@@ -110,9 +120,14 @@ namespace pboman3::ui {
         connect(ui_->actionFileSave, &QAction::triggered, this, &MainWindow::onFileSaveClick);
         connect(ui_->actionFileSaveAs, &QAction::triggered, this, &MainWindow::onFileSaveAsClick);
         connect(ui_->actionFileClose, &QAction::triggered, this, &MainWindow::onFileCloseClick);
+        connect(ui_->actionFileMerge, &QAction::triggered, this, &MainWindow::onFileMergeClick);
         connect(ui_->actionFileExit, &QAction::triggered, this, &MainWindow::close);
         connect(ui_->actionViewHeaders, &QAction::triggered, this, &MainWindow::onViewHeadersClick);
         connect(ui_->actionViewSignature, &QAction::triggered, this, &MainWindow::onViewSignatureClick);
+        connect(ui_->actionViewFindInContents, &QAction::triggered, searchPanel_, &ContentSearchPanel::startEditing);
+
+        connect(searchPanel_, &ContentSearchPanel::searchRequested, this, &MainWindow::startContentSearch);
+        connect(searchPanel_, &ContentSearchPanel::matchActivated, this, &MainWindow::contentMatchActivated);
 
         connect(ui_->actionSelectionExtractTo, &QAction::triggered, this, &MainWindow::selectionExtractToClick);
         connect(ui_->actionSelectionExtractFolder, &QAction::triggered, this, &MainWindow::selectionExtractFolderClick);
@@ -177,6 +192,32 @@ namespace pboman3::ui {
         }
     }
 
+    void MainWindow::onFileMergeClick() {
+        LOG(info, "User clicked the MergeFiles button - showing dialog")
+        const QStringList fileNames = QFileDialog::getOpenFileNames(this, "Select the PBOs to merge", "",
+                                                                    "PBO Files (*.pbo);;All Files (*.*)");
+        LOG(info, "The user chose to merge the files:", fileNames)
+        if (fileNames.isEmpty())
+            return;
+
+        MergeDialog dialog(fileNames.count(), this);
+        if (dialog.exec() != QDialog::DialogCode::Accepted)
+            return;
+
+        try {
+            const qsizetype conflicts = model_->mergeFiles(fileNames, dialog.resolution());
+            LOG(info, "Merged the files, conflicts:", conflicts)
+            ui_->statusBar->showMessage(
+                QString("Merged %1 PBO(s), %2 entries in conflict").arg(fileNames.count()).arg(conflicts), 10000);
+        } catch (const PboFileFormatException& ex) {
+            LOG(info, "Error when merging the files - show error modal:", ex)
+            UI_HANDLE_ERROR(ex)
+        } catch (const DiskAccessException& ex) {
+            LOG(info, "Error when merging the files - show error modal:", ex)
+            UI_HANDLE_ERROR(ex)
+        }
+    }
+
     void MainWindow::onViewHeadersClick() {
         LOG(info, "User clicked the ViewHeaders button")
         HeadersDialog(model_->document()->headers(), this).exec();
@@ -187,6 +228,60 @@ namespace pboman3::ui {
         SignatureDialog(&model_->document()->signature(), this).exec();
     }
 
+    void MainWindow::startContentSearch(const QString& pattern, bool regex, bool caseSensitive) {
+        if (!model_->isLoaded())
+            return;
+
+        const ContentSearch search(pattern, regex, caseSensitive);
+        if (!search.isValid()) {
+            LOG(info, "The search is invalid - show error modal:", search.errorString())
+            ErrorDialog(search.errorString(), this).exec();
+            return;
+        }
+
+        LOG(info, "Searching the contents for:", pattern, "Regex:", regex, "CaseSensitive:", caseSensitive)
+        searchPanel_->clearMatches();
+        searchPanel_->setSearching(true);
+
+        const QList<ContentSearch::Entry> entries = ContentSearch::collectEntries(model_->document()->root());
+        const QFuture<ContentMatch> future = QtConcurrent::run(util::ExecutionPools::io(),
+            [search, entries](QPromise<ContentMatch>& promise) {
+                search.run(entries, [&promise](const ContentMatch& match) { promise.addResult(match); },
+                           [&promise]() { return promise.isCanceled(); });
+            });
+
+        setIsLoading(static_cast<QFuture<void>>(future), true);
+        searchWatcher_.setFuture(future);
+    }
+
+    void MainWindow::contentSearchResultsReady(int begin, int end) {
+        QList<ContentMatch> matches;
+        matches.reserve(end - begin);
+        for (int i = begin; i < end; i++)
+            matches.append(searchWatcher_.resultAt(i));
+
+        //the panel shows a limited number of matches, searching further would only waste the CPU
+        if (!searchPanel_->addMatches(matches) && !searchWatcher_.isCanceled()) {
+            LOG(info, "Too many matches - cancel the search")
+            searchWatcher_.cancel();
+        }
+    }
+
+    void MainWindow::contentSearchComplete() const {
+        resetIsLoading();
+        searchPanel_->setSearching(false);
+        LOG(info, "The content search is complete, cancelled:", searchWatcher_.isCanceled())
+    }
+
+    void MainWindow::contentMatchActivated(const PboPath& path) const {
+        if (!model_->isLoaded())
+            return;
+
+        LOG(info, "User activated the match in:", path)
+        if (const PboNode* node = model_->document()->root()->get(path))
+            ui_->treeWidget->selectNode(node);
+    }
+
     void MainWindow::selectionExtractToClick() {
         LOG(info, "User clicked the ExtractTo button - showing dialog")
         QString folderPath = QFileDialog::getExistingDirectory(this, "Select the directory");
@@ -344,7 +439,7 @@ namespace pboman3::ui {
     void MainWindow::saveFile(const QString& fileName) {
         LOG(info, "Saving the file")
 
-        const QFuture<int> future = QtConcurrent::run([this, &fileName](QPromise<int>& promise) {
+        const QFuture<int> future = QtConcurrent::run(util::ExecutionPools::io(), [this, &fileName](QPromise<int>& promise) {
             model_->saveFile([&promise]() { return promise.isCanceled(); }, fileName);
             promise.addResult(0);
         });
@@ -402,12 +497,17 @@ namespace pboman3::ui {
             ui_->actionSelectionDelete->setEnabled(false);
             ui_->actionSelectionRename->setEnabled(false);
             ui_->actionSelectionExtractTo->setEnabled(false);
+
+            searchPanel_->clearMatches();
+            searchPanel_->hide();
         }
 
         ui_->actionFileSaveAs->setEnabled(loaded);
         ui_->actionFileClose->setEnabled(loaded);
+        ui_->actionFileMerge->setEnabled(loaded);
         ui_->actionViewHeaders->setEnabled(loaded);
         ui_->actionViewSignature->setEnabled(loaded);
+        ui_->actionViewFindInContents->setEnabled(loaded);
     }
 
     void MainWindow::updateWindowTitle() {
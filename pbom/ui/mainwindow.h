@@ -3,6 +3,7 @@
 #include <QAction>
 #include <QDropEvent>
 #include <QMainWindow>
+#include "contentsearchpanel.h"
 #include "model/pbomodel.h"
 #include "treewidget/treewidget.h"
 
@@ -31,6 +32,8 @@ namespace pboman3::ui {
         PboModel* model_;
         QFutureWatcher<int> saveWatcher_;
         QFutureWatcher<int> loadWatcher_;
+        QFutureWatcher<ContentMatch> searchWatcher_;
+        ContentSearchPanel* searchPanel_;
         bool hasChanges_;
 
         void loadComplete();
@@ -47,10 +50,20 @@ namespace pboman3::ui {
 
         void onFileCloseClick();
 
+        void onFileMergeClick();
+
         void onViewHeadersClick();
 
         void onViewSignatureClick();
 
+        void startContentSearch(const QString& pattern, bool regex, bool caseSensitive);
+
+        void contentSearchResultsReady(int begin, int end);
+
+        void contentSearchComplete() const;
+
+        void contentMatchActivated(const PboPath& path) const;
+
         void selectionExtractToClick();
 
         void selectionExtractFolderClick() const;
@@ -0,0 +1,24 @@
+#include "mergedialog.h"
+
+namespace pboman3::ui {
+    MergeDialog::MergeDialog(qsizetype fileCount, QWidget* parent)
+        : QDialog(parent),
+          ui_(new Ui::MergeDialog) {
+        ui_->setupUi(this);
+        ui_->label->setText(
+            QString("The entries of %1 PBO(s) will be added to the file. "
+                "What to do with the entries the file already has?").arg(fileCount));
+    }
+
+    MergeDialog::~MergeDialog() {
+        delete ui_;
+    }
+
+    ConflictResolution MergeDialog::resolution() const {
+        if (ui_->radioCopy->isChecked())
+            return ConflictResolution::Copy;
+        if (ui_->radioReplace->isChecked())
+            return ConflictResolution::Replace;
+        return ConflictResolution::Skip;
+    }
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <QDialog>
+#include "domain/conflictresolution.h"
+#include "ui_mergedialog.h"
+
+namespace Ui {
+    class MergeDialog;
+}
+
+namespace pboman3::ui {
+    using namespace domain;
+
+    class MergeDialog : public QDialog {
+    Q_OBJECT
+    public:
+        MergeDialog(qsizetype fileCount, QWidget* parent = nullptr);
+
+        ~MergeDialog() override;
+
+        //what to do with the merged entries already present in the document
+        ConflictResolution resolution() const;
+
+    private:
+        Ui::MergeDialog* ui_;
+    };
+}
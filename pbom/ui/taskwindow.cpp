@@ -35,6 +35,7 @@ namespace pboman3::ui {
         connect(model.get(), &TaskWindowModel::threadProgress, this, &TaskWindow::threadProgress);
         connect(model.get(), &TaskWindowModel::threadCompleted, this, &TaskWindow::threadCompleted);
         connect(model.get(), &TaskWindowModel::threadMessage, this, &TaskWindow::threadMessage);
+        connect(model.get(), &TaskWindowModel::overallProgress, this, &TaskWindow::overallProgress);
 
         model_->start();
     }
@@ -60,8 +61,6 @@ namespace pboman3::ui {
 
     void TaskWindow::threadInitialized(ThreadId threadId, const QString& text, qint32 minProgress,
                                        qint32 maxProgress) const {
-        taskbar_->threadInitialized(maxProgress);
-
         const ProgressWidget* progress = progressBars_.value(threadId);
         progress->setMinimum(minProgress);
         progress->setMaximum(maxProgress);
@@ -70,10 +69,10 @@ namespace pboman3::ui {
     }
 
     void TaskWindow::threadProgress(ThreadId threadId, qint32 progress) const {
-        taskbar_->threadProgress(threadId, progress);
-
+        //the aggregator timer might fire before the queued threadStarted of that thread is delivered
         const ProgressWidget* progressBar = progressBars_.value(threadId);
-        progressBar->setValue(progress);
+        if (progressBar)
+            progressBar->setValue(progress);
     }
 
     void TaskWindow::threadCompleted(ThreadId threadId) {
@@ -103,6 +102,11 @@ namespace pboman3::ui {
         log_->appendPlainText(message);
     }
 
+    void TaskWindow::overallProgress(qint64 processed, qint64 total) const {
+        if (taskbar_)
+            taskbar_->overallProgress(processed, total);
+    }
+
     void TaskWindow::buttonClicked(const QAbstractButton* button) {
         if (button == dynamic_cast<QAbstractButton*>(ui_->buttonBox->button(QDialogButtonBox::Cancel))) {
             ui_->buttonBox->setEnabled(false);
@@ -114,8 +118,7 @@ namespace pboman3::ui {
     }
 
     TaskWindow::TaskbarIndicator::TaskbarIndicator(WId windowId)
-        : maxValue_(0),
-          currentValue_(0) {
+        : currentValue_(0) {
         taskbar_ = QSharedPointer<ui::TaskbarIndicator>(new Win32TaskbarIndicator(windowId));
     }
 
@@ -124,16 +127,8 @@ namespace pboman3::ui {
             taskbar_->setIndeterminate();
     }
 
-    void TaskWindow::TaskbarIndicator::threadInitialized(qint64 maxProgress) {
-        maxValue_ += maxProgress;
-        taskbar_->setProgressValue(currentValue_, maxValue_);
-    }
-
-    void TaskWindow::TaskbarIndicator::threadProgress(ThreadId threadId, qint32 progress) {
-        const qint32 threadValue = threadValues_.value(threadId, 0);
-        const qint32 increment = progress - threadValue;
-        threadValues_.insert(threadId, progress);
-        currentValue_ += increment;
-        taskbar_->setProgressValue(currentValue_, maxValue_);
+    void TaskWindow::TaskbarIndicator::overallProgress(qint64 processed, qint64 total) {
+        currentValue_ = processed;
+        taskbar_->setProgressValue(currentValue_, total);
     }
 }
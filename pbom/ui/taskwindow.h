@@ -48,6 +48,8 @@ namespace pboman3::ui {
 
         void threadMessage(ThreadId threadId, const QString& message);
 
+        void overallProgress(qint64 processed, qint64 total) const;
+
         void buttonClicked(const QAbstractButton* button);
 
         class TaskbarIndicator {
@@ -56,14 +58,10 @@ namespace pboman3::ui {
 
             void threadThinking() const;
 
-            void threadInitialized(qint64 maxProgress);
-
-            void threadProgress(ThreadId threadId, qint32 progress);
+            void overallProgress(qint64 processed, qint64 total);
 
         private:
-            qint64 maxValue_;
             qint64 currentValue_;
-            QHash<ThreadId, qint32> threadValues_;
             QSharedPointer<ui::TaskbarIndicator> taskbar_;
         };
     };
@@ -10,6 +10,7 @@
 #include "io/diskaccessexception.h"
 #include "ui/errordialog.h"
 #include "ui/win32/win32fileviewer.h"
+#include "util/executionpools.h"
 #include "util/log.h"
 
 #define LOG(...) LOGGER("ui/treewidget/TreeWidget", __VA_ARGS__)
@@ -40,7 +41,7 @@ namespace pboman3::ui {
 
         const auto* selected = dynamic_cast<TreeWidgetItem*>(currentItem());
 
-        const QFuture<QString> future = QtConcurrent::run(
+        const QFuture<QString> future = QtConcurrent::run(util::ExecutionPools::io(),
             [this](QPromise<QString>& promise, const PboNode* node) {
                 LOG(info, "Extracting the node:", *node)
                 QString filePath = model_->execPrepare(node, [&promise]() { return promise.isCanceled(); });
@@ -64,7 +65,7 @@ namespace pboman3::ui {
         QList<PboNode*> selected = getSelectedHierarchies();
         LOG(info, selected.count(), "hierarchy items selected")
 
-        const QFuture<int> future = QtConcurrent::run(
+        const QFuture<int> future = QtConcurrent::run(util::ExecutionPools::io(),
             [this](QPromise<int>& promise,
                    const QString& pDir,
                    const PboNode* pRelativeTo,
@@ -152,7 +153,7 @@ namespace pboman3::ui {
     void TreeWidget::dragStarted(const QList<PboNode*>& items) {
         LOG(info, "Drag operation has started for", items.length(), "items")
 
-        const QFuture<InteractionParcel> future = QtConcurrent::run(
+        const QFuture<InteractionParcel> future = QtConcurrent::run(util::ExecutionPools::io(),
             [this](QPromise<InteractionParcel>& promise, const QList<PboNode*>& selection) {
                 LOG(info, "Extracting the selected items to the drive")
                 InteractionParcel data = model_->interactionPrepare(
@@ -224,7 +225,7 @@ namespace pboman3::ui {
         QList<PboNode*> nodes = getSelectedHierarchies();
         LOG(info, nodes.count(), "hierarchy items selected")
 
-        const QFuture<InteractionParcel> future = QtConcurrent::run(
+        const QFuture<InteractionParcel> future = QtConcurrent::run(util::ExecutionPools::io(),
             [this](QPromise<InteractionParcel>& promise, const QList<PboNode*>& selection) {
                 LOG(info, "Extracting the selected items to the drive")
                 InteractionParcel data = model_->interactionPrepare(
@@ -377,7 +378,7 @@ namespace pboman3::ui {
     void TreeWidget::addFilesFromFilesystem(const QList<QUrl>& urls) {
         LOG(info, "Add files from the file system:", urls)
 
-        const QFuture<QSharedPointer<NodeDescriptors>> future = QtConcurrent::run([&urls](QPromise<QSharedPointer<NodeDescriptors>>& promise) {
+        const QFuture<QSharedPointer<NodeDescriptors>> future = QtConcurrent::run(util::ExecutionPools::io(), [&urls](QPromise<QSharedPointer<NodeDescriptors>>& promise) {
             QSharedPointer<NodeDescriptors> files = FsCollector::collectFiles(urls, [&promise]() { return promise.isCanceled(); });
             promise.addResult(files);
         });
@@ -97,6 +97,35 @@ namespace pboman3::ui {
         return nullptr;
     }
 
+    void TreeWidgetBase::selectNode(const PboNode* node) {
+        if (!root_)
+            return;
+
+        QList<const PboNode*> chain;
+        for (const PboNode* p = node; p && p != root_->node(); p = p->parentNode())
+            chain.prepend(p);
+
+        QTreeWidgetItem* item = root_;
+        for (const PboNode* n : chain) {
+            QTreeWidgetItem* next = nullptr;
+            for (int i = 0; i < item->childCount(); i++) {
+                if (dynamic_cast<TreeWidgetItem*>(item->child(i))->node() == n) {
+                    next = item->child(i);
+                    break;
+                }
+            }
+            if (!next) {
+                LOG(warning, "The node is not in the tree:", *node)
+                return;
+            }
+            item->setExpanded(true);
+            item = next;
+        }
+
+        setCurrentItem(item);
+        scrollToItem(item);
+    }
+
     PboNode* TreeWidgetBase::getCurrentFolder() const {
         PboNode* result = nullptr;
         const auto* selected = dynamic_cast<TreeWidgetItem*>(currentItem());
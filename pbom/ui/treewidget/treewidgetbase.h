@@ -18,6 +18,9 @@ namespace pboman3::ui {
 
         PboNode* getSelectionRoot() const;
 
+        //expands the folders down to the node, selects it and scrolls it into view
+        void selectNode(const PboNode* node);
+
     protected:
         explicit TreeWidgetBase(QWidget* parent = nullptr);
 
@@ -0,0 +1,131 @@
+#include "util/log.h"
+#include <QThreadPool>
+#include <gtest/gtest.h>
+
+#define LOG(...) LOGGER("util/test/LogTest", __VA_ARGS__)
+
+namespace pboman3::util::test {
+    class LogTest : public testing::Test {
+    protected:
+        void TearDown() override {
+            SetMinLogLevel(LogLevel::debug);
+        }
+    };
+
+    int CountEvaluation(int* counter) {
+        (*counter)++;
+        return *counter;
+    }
+
+    TEST_F(LogTest, Logger_Does_Not_Evaluate_Arguments_Of_Disabled_Level) {
+        int counter = 0;
+        SetMinLogLevel(LogLevel::warning);
+
+        LOG(debug, "Value:", CountEvaluation(&counter))
+        LOG(info, "Value:", CountEvaluation(&counter))
+        ASSERT_EQ(counter, 0);
+
+        LOG(warning, "Value:", CountEvaluation(&counter))
+        ASSERT_EQ(counter, 1);
+    }
+
+    TEST_F(LogTest, Logger_Keeps_Else_Bound_To_The_Outer_If) {
+        int counter = 0;
+        const bool condition = false;
+
+        if (condition)
+            LOG(info, "Not reached")
+        else
+            CountEvaluation(&counter);
+
+        ASSERT_EQ(counter, 1);
+    }
+
+    TEST(LogRingBufferTest, TryPop_Returns_Records_In_Push_Order) {
+        LogRingBuffer buffer(4);
+        ASSERT_TRUE(buffer.tryPush(QtInfoMsg, "file1", "message1"));
+        ASSERT_TRUE(buffer.tryPush(QtWarningMsg, "file2", "message2"));
+
+        LogRingBuffer::Record record;
+        ASSERT_TRUE(buffer.tryPop(record));
+        ASSERT_EQ(record.type, QtInfoMsg);
+        ASSERT_STREQ(record.file, "file1");
+        ASSERT_EQ(QByteArray(record.text, record.textLength), "message1");
+
+        ASSERT_TRUE(buffer.tryPop(record));
+        ASSERT_EQ(record.type, QtWarningMsg);
+        ASSERT_STREQ(record.file, "file2");
+        ASSERT_EQ(QByteArray(record.text, record.textLength), "message2");
+
+        ASSERT_FALSE(buffer.tryPop(record));
+    }
+
+    TEST(LogRingBufferTest, TryPush_Returns_False_When_Full) {
+        LogRingBuffer buffer(2);
+        ASSERT_TRUE(buffer.tryPush(QtInfoMsg, nullptr, "1"));
+        ASSERT_TRUE(buffer.tryPush(QtInfoMsg, nullptr, "2"));
+        ASSERT_FALSE(buffer.tryPush(QtInfoMsg, nullptr, "3"));
+
+        LogRingBuffer::Record record;
+        ASSERT_TRUE(buffer.tryPop(record));
+        ASSERT_TRUE(buffer.tryPush(QtInfoMsg, nullptr, "3"));
+    }
+
+    TEST(LogRingBufferTest, TryPush_Cuts_Long_Texts) {
+        LogRingBuffer buffer(2);
+        ASSERT_TRUE(buffer.tryPush(QtInfoMsg, nullptr, QByteArray(LogRingBuffer::textSize * 2, 'a')));
+
+        LogRingBuffer::Record record;
+        ASSERT_TRUE(buffer.tryPop(record));
+        ASSERT_EQ(record.textLength, LogRingBuffer::textSize);
+        ASSERT_TRUE(QByteArray(record.text, record.textLength).endsWith("\xE2\x80\xA6"));
+        ASSERT_STREQ(record.file, "");
+    }
+
+    TEST(LogRingBufferTest, TryPush_Cuts_Long_Texts_On_Character_Boundary) {
+        LogRingBuffer buffer(2);
+        //2-byte characters, the byte limit before the ellipsis falls in the middle of one
+        const QByteArray text = QString(LogRingBuffer::textSize, QChar(0x00E9)).toUtf8();
+        ASSERT_TRUE(buffer.tryPush(QtInfoMsg, nullptr, text));
+
+        LogRingBuffer::Record record;
+        ASSERT_TRUE(buffer.tryPop(record));
+        ASSERT_LE(record.textLength, LogRingBuffer::textSize);
+
+        const QString cut = QString::fromUtf8(record.text, record.textLength);
+        ASSERT_FALSE(cut.contains(QChar::ReplacementCharacter));
+        ASSERT_TRUE(cut.endsWith(QChar(0x2026)));
+    }
+
+    TEST(LogRingBufferTest, TryPush_Keeps_Records_Of_Concurrent_Producers) {
+        LogRingBuffer buffer(64);
+        constexpr int producers = 4;
+        constexpr int perProducer = 1000;
+
+        QThreadPool pool;
+        pool.setMaxThreadCount(producers);
+        for (int p = 0; p < producers; p++) {
+            pool.start([&buffer, p]() {
+                for (int i = 0; i < perProducer; i++) {
+                    const QByteArray text = QByteArray::number(p);
+                    while (!buffer.tryPush(QtInfoMsg, nullptr, text))
+                        QThread::yieldCurrentThread();
+                }
+            });
+        }
+
+        int counts[producers] = {};
+        int total = 0;
+        LogRingBuffer::Record record;
+        while (total < producers * perProducer) {
+            if (buffer.tryPop(record)) {
+                counts[QByteArray(record.text, record.textLength).toInt()]++;
+                total++;
+            }
+        }
+        pool.waitForDone();
+
+        for (const int count : counts)
+            ASSERT_EQ(count, perProducer);
+    }
+}
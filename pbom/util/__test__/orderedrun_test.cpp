@@ -0,0 +1,48 @@
+#include "util/orderedrun.h"
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
+#include <gtest/gtest.h>
+
+namespace pboman3::util::test {
+    TEST(OrderedRunTest, RunOrdered_Consumes_Results_In_Order) {
+        QThreadPool pool;
+        pool.setMaxThreadCount(4);
+
+        QList<qsizetype> consumed;
+        RunOrdered<qsizetype>(&pool, 4, 100, [](qsizetype index) {
+            //the later jobs finish first
+            QThread::usleep(static_cast<unsigned long>(100 - index));
+            return index * 2;
+        }, [&consumed](qsizetype index, qsizetype& result) {
+            ASSERT_EQ(result, index * 2);
+            consumed.append(index);
+        });
+
+        ASSERT_EQ(consumed.count(), 100);
+        for (qsizetype i = 0; i < consumed.count(); i++)
+            ASSERT_EQ(consumed.at(i), i);
+    }
+
+    TEST(OrderedRunTest, RunOrdered_Completes_If_Pool_Is_Busy) {
+        QThreadPool pool;
+        pool.setMaxThreadCount(1);
+
+        QSemaphore blocker;
+        pool.start([&blocker]() { blocker.acquire(); });
+
+        //the workers can not start, so the calling thread runs all the jobs
+        int sum = 0;
+        RunOrdered<int>(&pool, 4, 10, [](qsizetype index) {
+            return static_cast<int>(index);
+        }, [&sum](qsizetype, int& result) {
+            sum += result;
+        });
+
+        ASSERT_EQ(sum, 45);
+        ASSERT_EQ(pool.activeThreadCount(), 1);
+
+        blocker.release();
+        pool.waitForDone();
+    }
+}
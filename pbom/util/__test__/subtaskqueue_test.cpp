@@ -0,0 +1,77 @@
+#include "util/subtaskqueue.h"
+#include <QAtomicInt>
+#include <QThreadPool>
+#include <gtest/gtest.h>
+#include "exception.h"
+
+namespace pboman3::util::test {
+    TEST(SubtaskQueueTest, Execute_Runs_All_Subtasks_Without_Helpers) {
+        SubtaskQueue queue;
+
+        QAtomicInt counter;
+        QList<SubtaskQueue::Subtask> subtasks;
+        for (int i = 0; i < 10; i++)
+            subtasks.append([&counter]() { counter.fetchAndAddRelaxed(1); });
+
+        queue.execute(subtasks);
+
+        ASSERT_EQ(counter.loadRelaxed(), 10);
+        ASSERT_FALSE(queue.help());
+    }
+
+    TEST(SubtaskQueueTest, Execute_Runs_Subtasks_On_Helping_Threads) {
+        SubtaskQueue queue;
+
+        QAtomicInt counter;
+        QAtomicInt stopped;
+        QThreadPool pool;
+        pool.setMaxThreadCount(3);
+        for (int i = 0; i < 3; i++) {
+            pool.start([&queue, &stopped]() {
+                while (!stopped.loadAcquire()) {
+                    if (!queue.help())
+                        queue.waitForWork(10);
+                }
+            });
+        }
+
+        QList<SubtaskQueue::Subtask> subtasks;
+        for (int i = 0; i < 100; i++)
+            subtasks.append([&counter]() { counter.fetchAndAddRelaxed(1); });
+
+        queue.execute(subtasks);
+        ASSERT_EQ(counter.loadRelaxed(), 100);
+
+        stopped.storeRelease(1);
+        pool.waitForDone();
+    }
+
+    TEST(SubtaskQueueTest, Close_Wakes_Waiting_Threads) {
+        SubtaskQueue queue;
+
+        QThreadPool pool;
+        pool.setMaxThreadCount(3);
+        for (int i = 0; i < 3; i++)
+            pool.start([&queue]() { queue.waitForWork(); });
+
+        queue.close();
+        ASSERT_TRUE(pool.waitForDone(5000));
+
+        //the waits after closing do not block at all
+        queue.waitForWork();
+    }
+
+    TEST(SubtaskQueueTest, Execute_Rethrows_And_Skips_The_Rest_On_Failure) {
+        SubtaskQueue queue;
+
+        int counter = 0;
+        QList<SubtaskQueue::Subtask> subtasks;
+        subtasks.append([&counter]() { counter++; });
+        subtasks.append([]() { throw InvalidOperationException("Subtask failed"); });
+        subtasks.append([&counter]() { counter++; });
+
+        ASSERT_THROW(queue.execute(subtasks), InvalidOperationException);
+        ASSERT_EQ(counter, 1);
+        ASSERT_FALSE(queue.help());
+    }
+}
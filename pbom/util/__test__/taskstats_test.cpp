@@ -0,0 +1,55 @@
+#include "util/taskstats.h"
+#include <gtest/gtest.h>
+
+namespace pboman3::util::test {
+    TEST(TaskStatsTest, AddPhase_Sums_Up_Phases_With_The_Same_Name) {
+        TaskStats stats;
+        stats.addPhase(PhaseStats{"compress", 10, 5, 100, 40});
+        stats.addPhase(PhaseStats{"copy body", 3, 1, 40, 40});
+        stats.addPhase(PhaseStats{"compress", 20, 15, 100, 60});
+
+        const QList<PhaseStats> phases = stats.phases();
+        ASSERT_EQ(phases.count(), 2);
+        ASSERT_EQ(phases.at(0).name, "compress");
+        ASSERT_EQ(phases.at(0).wallNs, 30);
+        ASSERT_EQ(phases.at(0).cpuNs, 20);
+        ASSERT_EQ(phases.at(0).bytesIn, 200);
+        ASSERT_EQ(phases.at(0).bytesOut, 100);
+        ASSERT_DOUBLE_EQ(phases.at(0).ratio(), 0.5);
+        ASSERT_EQ(phases.at(1).name, "copy body");
+    }
+
+    TEST(TaskStatsTest, Total_Uses_Task_Wall_Time_And_Phases_Cpu_Time) {
+        TaskStats stats;
+        stats.addPhase(PhaseStats{"compress", 10, 5, 0, 0});
+        stats.addPhase(PhaseStats{"copy body", 3, 1, 0, 0});
+        stats.setWallNs(12);
+        stats.setBytes(100, 50);
+
+        const PhaseStats total = stats.total();
+        ASSERT_EQ(total.wallNs, 12);
+        ASSERT_EQ(total.cpuNs, 6);
+        ASSERT_EQ(total.bytesIn, 100);
+        ASSERT_EQ(total.bytesOut, 50);
+    }
+
+    TEST(TaskStatsTest, ScopedPhase_Records_The_Phase) {
+        TaskStats stats;
+        {
+            ScopedPhase phase(&stats, "scan");
+            phase.addBytes(7, 3);
+        }
+
+        const QList<PhaseStats> phases = stats.phases();
+        ASSERT_EQ(phases.count(), 1);
+        ASSERT_EQ(phases.at(0).name, "scan");
+        ASSERT_GE(phases.at(0).wallNs, 0);
+        ASSERT_EQ(phases.at(0).bytesIn, 7);
+        ASSERT_EQ(phases.at(0).bytesOut, 3);
+    }
+
+    TEST(TaskStatsTest, ScopedPhase_Does_Nothing_Without_Stats) {
+        ScopedPhase phase(nullptr, "scan");
+        phase.addBytes(7, 3);
+    }
+}
@@ -0,0 +1,60 @@
+#include "util/tracer.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <gtest/gtest.h>
+
+namespace pboman3::util::test {
+    QJsonArray ReadTraceEvents(const QString& path) {
+        QFile file(path);
+        file.open(QIODeviceBase::ReadOnly);
+        return QJsonDocument::fromJson(file.readAll()).object().value("traceEvents").toArray();
+    }
+
+    QList<QJsonObject> FindEvents(const QJsonArray& events, const QString& name) {
+        QList<QJsonObject> result;
+        for (const QJsonValue& event : events) {
+            if (event.toObject().value("name").toString() == name)
+                result.append(event.toObject());
+        }
+        return result;
+    }
+
+    TEST(TracerTest, StopAndWrite_Writes_Recorded_Scopes) {
+        const QTemporaryDir dir;
+        const QString path = dir.filePath("trace.json");
+
+        Tracer::start();
+        {
+            TRACE_SCOPE("test", "outer", "detail")
+            TRACE_SCOPE("test", "inner")
+        }
+        ASSERT_TRUE(Tracer::stopAndWrite(path));
+
+        const QJsonArray events = ReadTraceEvents(path);
+        const QList<QJsonObject> outer = FindEvents(events, "outer");
+        ASSERT_EQ(outer.count(), 1);
+        ASSERT_EQ(outer.at(0).value("cat").toString(), "test");
+        ASSERT_EQ(outer.at(0).value("ph").toString(), "X");
+        ASSERT_EQ(outer.at(0).value("args").toObject().value("detail").toString(), "detail");
+
+        const QList<QJsonObject> inner = FindEvents(events, "inner");
+        ASSERT_EQ(inner.count(), 1);
+        ASSERT_EQ(inner.at(0).value("tid"), outer.at(0).value("tid"));
+        ASSERT_GE(inner.at(0).value("ts").toInteger(), outer.at(0).value("ts").toInteger());
+    }
+
+    TEST(TracerTest, TraceScope_Records_Nothing_When_Disabled) {
+        const QTemporaryDir dir;
+        const QString path = dir.filePath("trace.json");
+
+        {
+            TRACE_SCOPE("test", "ignored")
+        }
+        Tracer::start();
+        ASSERT_TRUE(Tracer::stopAndWrite(path));
+
+        ASSERT_TRUE(FindEvents(ReadTraceEvents(path), "ignored").isEmpty());
+    }
+}
@@ -0,0 +1,23 @@
+#include "executionpools.h"
+#include <QThread>
+
+namespace pboman3::util {
+    QThreadPool* ExecutionPools::io() {
+        static QThreadPool* pool = [] {
+            auto* p = new QThreadPool();
+            //the threads spend most of the time blocked, a few extra ones keep the disk queue filled
+            p->setMaxThreadCount(QThread::idealThreadCount() + 2);
+            return p;
+        }();
+        return pool;
+    }
+
+    QThreadPool* ExecutionPools::compute() {
+        static QThreadPool* pool = [] {
+            auto* p = new QThreadPool();
+            p->setMaxThreadCount(QThread::idealThreadCount());
+            return p;
+        }();
+        return pool;
+    }
+}
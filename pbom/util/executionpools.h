@@ -0,0 +1,15 @@
+#pragma once
+
+#include <QThreadPool>
+
+namespace pboman3::util {
+    //the disk-bound and the CPU-bound work run on separate pools, so that one kind does not take the slots of the other
+    class ExecutionPools {
+    public:
+        //for the work mostly waiting for the disk: reading, writing and extracting the files
+        static QThreadPool* io();
+
+        //for the work mostly busy with the CPU: compression
+        static QThreadPool* compute();
+    };
+}
@@ -1,44 +1,196 @@
 #include "log.h"
 #include <QLoggingCategory>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 
 namespace pboman3::util {
-    LogWorker::LogWorker(QtMessageHandler implementation)
-        : implementation_(implementation) {
+    LogRingBuffer::LogRingBuffer(qsizetype capacity)
+        : cells_(new Cell[capacity]),
+          mask_(static_cast<size_t>(capacity) - 1),
+          enqueuePos_(0),
+          dequeuePos_(0) {
+        assert(capacity > 0 && (capacity & (capacity - 1)) == 0 && "Capacity must be a power of two");
+        for (size_t i = 0; i <= mask_; i++)
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
     }
 
-    void LogWorker::handleMessage(QtMsgType type, const QString& file, const QString& message) const {
-        implementation_(type, QMessageLogContext(file.toUtf8(), 0, nullptr, nullptr), message);
+    bool LogRingBuffer::tryPush(QtMsgType type, const char* file, const QByteArray& text) {
+        //the cell sequence tells whether the cell is free for the given position, see D. Vyukov's bounded queue
+        Cell* cell;
+        size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &cells_[pos & mask_];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        Record& record = cell->record;
+        record.type = type;
+        const qsizetype fileLength = file ? std::min(static_cast<qsizetype>(strlen(file)), fileSize - 1) : 0;
+        if (fileLength)
+            memcpy(record.file, file, fileLength);
+        record.file[fileLength] = 0;
+        if (text.length() <= textSize) {
+            record.textLength = text.length();
+            memcpy(record.text, text.constData(), record.textLength);
+        } else {
+            static constexpr char ellipsis[] = "\xE2\x80\xA6";
+            qsizetype cut = textSize - static_cast<qsizetype>(sizeof ellipsis - 1);
+            //do not split a multibyte character: step back over its continuation bytes
+            while (cut > 0 && (static_cast<quint8>(text.at(cut)) & 0xC0) == 0x80)
+                cut--;
+            memcpy(record.text, text.constData(), cut);
+            memcpy(record.text + cut, ellipsis, sizeof ellipsis - 1);
+            record.textLength = cut + static_cast<qsizetype>(sizeof ellipsis - 1);
+        }
+
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool LogRingBuffer::tryPop(Record& record) {
+        Cell& cell = cells_[dequeuePos_ & mask_];
+        const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (sequence != dequeuePos_ + 1)
+            return false;
+
+        record = cell.record;
+        cell.sequence.store(dequeuePos_ + mask_ + 1, std::memory_order_release);
+        dequeuePos_++;
+        return true;
     }
 
     LoggingInfrastructure::LoggingInfrastructure()
-        : worker_(nullptr) {
+        : buffer_(2048),
+          implementation_(nullptr) {
         assert(!LoggingInfrastructure::logging_);
         logging_ = this;
     }
 
     LoggingInfrastructure::~LoggingInfrastructure() {
         assert(LoggingInfrastructure::logging_ == this);
-        logging_ = nullptr;
 
-        thread_.exit();
-        thread_.wait();
+        if (thread_) {
+            //the messages from now on go straight to the output, the ones in the buffer are written out
+            qInstallMessageHandler(implementation_);
+            stopped_.storeRelease(1);
+            drainWakeup_.release();
+            thread_->wait();
+        }
 
-        delete worker_;
+        logging_ = nullptr;
     }
 
     void LoggingInfrastructure::run() {
         UseLoggingMessagePattern();
-        worker_ = new LogWorker(qInstallMessageHandler(handleMessage));
-        worker_->moveToThread(&thread_);
-        thread_.start(QThread::LowPriority);
-        connect(this, &LoggingInfrastructure::messageReceived, worker_, &LogWorker::handleMessage);
+        thread_.reset(QThread::create([this]() { drain(); }));
+        thread_->start(QThread::LowPriority);
+        implementation_ = qInstallMessageHandler(handleMessage);
     }
 
     void LoggingInfrastructure::handleMessage(QtMsgType type,
                                               const QMessageLogContext& context,
                                               const QString& message) {
         assert(LoggingInfrastructure::logging_);
-        emit logging_->messageReceived(type, context.file, message);
+        logging_->push(type, context, message);
+    }
+
+    void LoggingInfrastructure::push(QtMsgType type, const QMessageLogContext& context, const QString& message) {
+        if (type == QtFatalMsg) {
+            //the app is about to abort, the message must not wait in the buffer
+            implementation_(type, context, message);
+            return;
+        }
+
+        const QByteArray text = message.toUtf8();
+        while (!buffer_.tryPush(type, context.file, text)) {
+            if (type == QtDebugMsg || type == QtInfoMsg) {
+                dropped_.fetchAndAddRelaxed(1);
+                return;
+            }
+            if (stopped_.loadAcquire()) {
+                //the drain thread might have already exited, nobody would make the room
+                implementation_(type, context, message);
+                return;
+            }
+            wakeDrain();
+            QThread::yieldCurrentThread();
+        }
+
+        if (stopped_.loadAcquire()) {
+            //the drain thread might have already written out the buffer and exited
+            flushStopped();
+            return;
+        }
+        wakeDrain();
+    }
+
+    void LoggingInfrastructure::flushStopped() {
+        //blocks while the drain thread is still running, then it is safe to consume the buffer here
+        QMutexLocker locker(&consumerMutex_);
+        LogRingBuffer::Record record;
+        while (buffer_.tryPop(record))
+            write(record);
+        reportDropped();
+    }
+
+    void LoggingInfrastructure::wakeDrain() {
+        if (drainWaiting_.testAndSetOrdered(1, 0))
+            drainWakeup_.release();
+    }
+
+    void LoggingInfrastructure::drain() {
+        QMutexLocker locker(&consumerMutex_);
+        LogRingBuffer::Record record;
+        while (true) {
+            if (buffer_.tryPop(record)) {
+                write(record);
+                continue;
+            }
+
+            reportDropped();
+            if (stopped_.loadAcquire()) {
+                //a producer might have pushed in between the pop and the stop check
+                while (buffer_.tryPop(record))
+                    write(record);
+                break;
+            }
+
+            drainWaiting_.storeOrdered(1);
+            if (buffer_.tryPop(record)) {
+                //a message came in before the drain announced it waits
+                drainWaiting_.storeRelease(0);
+                write(record);
+                continue;
+            }
+            //the timeout covers a producer that has taken a cell, but not filled it yet
+            drainWakeup_.tryAcquire(1, 100);
+            drainWaiting_.storeRelease(0);
+        }
+    }
+
+    void LoggingInfrastructure::write(const LogRingBuffer::Record& record) const {
+        implementation_(record.type, QMessageLogContext(record.file, 0, nullptr, nullptr),
+                        QString::fromUtf8(record.text, record.textLength));
+    }
+
+    void LoggingInfrastructure::reportDropped() {
+        const quint64 dropped = dropped_.fetchAndStoreRelaxed(0);
+        if (dropped > 0) {
+            const QString message = QString("%1 debug and info log messages were dropped as the log could not keep up")
+                .arg(dropped);
+            implementation_(QtWarningMsg, QMessageLogContext("util/LoggingInfrastructure", 0, nullptr, nullptr),
+                            message);
+        }
     }
 
     void UseLoggingMessagePattern() {
@@ -46,9 +198,14 @@ namespace pboman3::util {
             "%{time yyyy-MM-dd HH:mm:ss.zzz}|%{if-debug}DBG%{endif}%{if-info}INF%{endif}%{if-warning}WRN%{endif}%{if-critical}CRT%{endif}%{if-fatal}FTL%{endif}|%{file}|%{message}");
 #ifdef NDEBUG  
         QLoggingCategory::setFilterRules("*.debug=false");
+        SetMinLogLevel(LogLevel::info);
 #endif
 
     }
 
+    void SetMinLogLevel(int level) {
+        MinLogLevel.store(std::max(level, PBOM_LOG_MIN_LEVEL), std::memory_order_relaxed);
+    }
+
     LoggingInfrastructure* LoggingInfrastructure::logging_ = nullptr;
 }
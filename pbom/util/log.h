@@ -1,6 +1,8 @@
 #pragma once
 
 #include <QDebug>
+#include <atomic>
+#include <memory>
 
 #define M_NUM_ARGS_10TH(A10, A9, A8, A7, A6, A5, A4, A3, A2, A1, A0, ...) A0
 #define M_NUM_ARGS(...) M_NUM_ARGS_10TH(__VA_ARGS__, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1)
@@ -20,7 +22,17 @@
 #define M_LOG_IMPL2(TARGET, N, ...) M_LOG_IMPL3(TARGET, N, __VA_ARGS__)
 #define M_LOG_IMPL(LOG, LEVEL, ...) M_LOG_IMPL2(LOG.LEVEL(), M_NUM_ARGS(__VA_ARGS__), __VA_ARGS__)
 
-#define LOGGER(CLASS, ...) M_LOG_IMPL(QMessageLogger(CLASS, QT_MESSAGELOG_LINE, QT_MESSAGELOG_FUNC), __VA_ARGS__);
+//the levels below PBOM_LOG_MIN_LEVEL are compiled out, see the PBOM_STRIP_DEBUG_LOG CMake option
+#ifndef PBOM_LOG_MIN_LEVEL
+#define PBOM_LOG_MIN_LEVEL 0
+#endif
+
+//a disabled level costs a single branch: neither the logger, nor the arguments are evaluated
+//the empty "if" branch keeps "if (x) LOG(...) else ..." binding the "else" to the caller's "if"
+#define LOGGER(CLASS, LEVEL, ...) \
+    if constexpr (pboman3::util::LogLevel::LEVEL < PBOM_LOG_MIN_LEVEL) {} \
+    else if (!pboman3::util::IsLogLevelEnabled(pboman3::util::LogLevel::LEVEL)) {} \
+    else M_LOG_IMPL(QMessageLogger(CLASS, QT_MESSAGELOG_LINE, QT_MESSAGELOG_FUNC), LEVEL, __VA_ARGS__);
 
 /*
 USE THIS CODE FOR MACRO DEBUGGING
@@ -29,45 +41,106 @@ USE THIS CODE FOR MACRO DEBUGGING
 #pragma message(DEBUG_STRING(LOGGER("Main", debug, "Hello!")))
 */
 
+#include <QAtomicInt>
+#include <QMutex>
 #include <QScopedPointer>
+#include <QSemaphore>
 #include <QThread>
 
 #define ACTIVATE_ASYNC_LOG_SINK auto logging = QScopedPointer(new util::LoggingInfrastructure); logging->run();
 
 namespace pboman3::util {
-    /*These two guys make standard QT logs be output on a non UI-thread*/
-    /*as UI-thread output has too big UI responsiveness penalty*/
-    class LogWorker : public QObject {
-    Q_OBJECT
+    struct LogLevel {
+        static constexpr int debug = 0;
+        static constexpr int info = 1;
+        static constexpr int warning = 2;
+        static constexpr int critical = 3;
+        static constexpr int fatal = 4;
+    };
+
+    inline std::atomic<int> MinLogLevel{PBOM_LOG_MIN_LEVEL};
+
+    inline bool IsLogLevelEnabled(int level) {
+        return level >= MinLogLevel.load(std::memory_order_relaxed);
+    }
+
+    //the levels below this one are skipped at run time, the ones compiled out can not be turned back on
+    void SetMinLogLevel(int level);
+
+    //a bounded multi-producer single-consumer queue of the log records, free of locks
+    //the records are fixed-size, so pushing a message does not allocate
+    class LogRingBuffer {
     public:
-        LogWorker(QtMessageHandler implementation);
+        static constexpr qsizetype fileSize = 64;
+        static constexpr qsizetype textSize = 448;
+
+        struct Record {
+            QtMsgType type;
+            char file[fileSize];
+            char text[textSize];
+            qsizetype textLength;
+        };
+
+        //the capacity must be a power of two
+        explicit LogRingBuffer(qsizetype capacity);
+
+        //returns false if the buffer is full
+        //the texts longer than textSize are cut on a UTF-8 character boundary and end with an ellipsis
+        bool tryPush(QtMsgType type, const char* file, const QByteArray& text);
 
-    public slots:
-        void handleMessage(QtMsgType type, const QString& file, const QString& message) const;
+        //must be called from one thread at a time
+        bool tryPop(Record& record);
 
     private:
-        QtMessageHandler implementation_;
+        struct Cell {
+            std::atomic<size_t> sequence;
+            Record record;
+        };
+
+        std::unique_ptr<Cell[]> cells_;
+        size_t mask_;
+        alignas(64) std::atomic<size_t> enqueuePos_;
+        alignas(64) size_t dequeuePos_;
     };
 
-    class LoggingInfrastructure : public QObject {
-    Q_OBJECT
+    /*Makes standard QT logs be output on a non UI-thread*/
+    /*as UI-thread output has too big UI responsiveness penalty*/
+    class LoggingInfrastructure {
     public:
         LoggingInfrastructure();
 
-        ~LoggingInfrastructure() override;
+        ~LoggingInfrastructure();
 
         void run();
 
-    signals:
-        void messageReceived(QtMsgType type, const QString& file, const QString& message);
-
     private:
         static LoggingInfrastructure* logging_;
 
         static void handleMessage(QtMsgType type, const QMessageLogContext& context, const QString& message);
 
-        QThread thread_;
-        LogWorker* worker_;
+        //debug and info messages are dropped when the buffer is full, the more severe ones wait for the room
+        void push(QtMsgType type, const QMessageLogContext& context, const QString& message);
+
+        void drain();
+
+        //wakes the drain thread if it waits for the messages
+        void wakeDrain();
+
+        //writes out the messages pushed after the drain thread has finished
+        void flushStopped();
+
+        void write(const LogRingBuffer::Record& record) const;
+
+        void reportDropped();
+
+        LogRingBuffer buffer_;
+        QAtomicInt stopped_;
+        QAtomicInt drainWaiting_;
+        QSemaphore drainWakeup_;
+        QMutex consumerMutex_; //the buffer has a single consumer: the drain thread, then the producers flushing it
+        QAtomicInteger<quint64> dropped_;
+        QScopedPointer<QThread> thread_;
+        QtMessageHandler implementation_;
     };
 
     void UseLoggingMessagePattern();
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <QList>
+#include <QMutex>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThreadPool>
+#include <QWaitCondition>
+#include <functional>
+#include <memory>
+#include <optional>
+
+namespace pboman3::util {
+    //runs the jobs on several threads and hands their results to the calling thread in the order of the jobs,
+    //so that the output of a batch can be streamed while it is still being produced
+    //the jobs run on `threads` threads at most: the calling thread and the workers started on the pool;
+    //the calling thread runs the jobs itself while waiting, so a busy shared pool slows the run down but never stalls it
+    //the jobs run at most 4 results ahead of the consumer per thread; a job must not throw
+    template <typename T>
+    void RunOrdered(QThreadPool* pool, int threads, qsizetype count, const std::function<T(qsizetype)>& job,
+                    const std::function<void(qsizetype, T&)>& consume) {
+        if (threads <= 1 || count <= 1) {
+            for (qsizetype i = 0; i < count; i++) {
+                T result = job(i);
+                consume(i, result);
+            }
+            return;
+        }
+
+        QMutex mutex;
+        QWaitCondition changed;
+        QList<std::optional<T>> results(count);
+        qsizetype next = 0;
+        qsizetype consumed = 0;
+        const qsizetype window = static_cast<qsizetype>(threads) * 4;
+
+        //the caller holds the mutex, returns false if there is no job to pick yet
+        auto runNext = [&](QMutexLocker<QMutex>& locker) {
+            if (next >= count || next - consumed >= window)
+                return false;
+            const qsizetype index = next++;
+            locker.unlock();
+            T result = job(index);
+            locker.relock();
+            results[index] = std::move(result);
+            changed.wakeAll();
+            return true;
+        };
+
+        QSemaphore workersDone;
+        auto worker = [&]() {
+            {
+                QMutexLocker locker(&mutex);
+                while (next < count) {
+                    if (!runNext(locker))
+                        changed.wait(&mutex);
+                }
+            }
+            workersDone.release();
+        };
+
+        //the pool is shared, so the workers are tracked one by one instead of waiting for the whole pool
+        const int numWorkers = threads - 1;
+        QList<std::unique_ptr<QRunnable>> workers;
+        workers.reserve(numWorkers);
+        for (int i = 0; i < numWorkers; i++) {
+            workers.emplace_back(QRunnable::create(worker));
+            workers.back()->setAutoDelete(false);
+            pool->start(workers.back().get());
+        }
+
+        for (qsizetype i = 0; i < count; i++) {
+            T result;
+            {
+                QMutexLocker locker(&mutex);
+                while (!results[i]) {
+                    if (!runNext(locker))
+                        changed.wait(&mutex);
+                }
+                result = std::move(*results[i]);
+                results[i].reset();
+                consumed = i + 1;
+                changed.wakeAll();
+            }
+            consume(i, result);
+        }
+
+        //the workers still queued in the pool would never find a job, so they are taken back
+        int started = 0;
+        for (const std::unique_ptr<QRunnable>& w : workers) {
+            if (!pool->tryTake(w.get()))
+                started++;
+        }
+        workersDone.acquire(started);
+    }
+}
@@ -0,0 +1,106 @@
+#include "subtaskqueue.h"
+#include "util/log.h"
+
+#define LOG(...) LOGGER("util/SubtaskQueue", __VA_ARGS__)
+
+namespace pboman3::util {
+    void SubtaskQueue::execute(const QList<Subtask>& subtasks) {
+        if (subtasks.isEmpty())
+            return;
+
+        const auto batch = QSharedPointer<Batch>::create(Batch{&subtasks, 0, subtasks.count(), nullptr});
+
+        {
+            QMutexLocker locker(&mutex_);
+            batches_.append(batch);
+            workPublished_.wakeAll();
+        }
+
+        LOG(debug, "Published", subtasks.count(), "subtasks")
+
+        qsizetype index = claim(batch);
+        while (index >= 0) {
+            run(batch, index);
+            index = claim(batch);
+        }
+
+        QMutexLocker locker(&mutex_);
+        while (batch->pending > 0)
+            batchCompleted_.wait(&mutex_);
+
+        if (batch->error)
+            std::rethrow_exception(batch->error);
+    }
+
+    bool SubtaskQueue::help() {
+        QSharedPointer<Batch> batch;
+        {
+            QMutexLocker locker(&mutex_);
+            if (batches_.isEmpty())
+                return false;
+            batch = batches_.first();
+        }
+
+        const qsizetype index = claim(batch);
+        if (index < 0)
+            return false;
+
+        run(batch, index);
+        return true;
+    }
+
+    void SubtaskQueue::waitForWork(int msecs) {
+        QMutexLocker locker(&mutex_);
+        if (batches_.isEmpty() && !closed_)
+            workPublished_.wait(&mutex_, msecs);
+    }
+
+    void SubtaskQueue::waitForWork() {
+        QMutexLocker locker(&mutex_);
+        while (batches_.isEmpty() && !closed_)
+            workPublished_.wait(&mutex_);
+    }
+
+    void SubtaskQueue::close() {
+        QMutexLocker locker(&mutex_);
+        closed_ = true;
+        workPublished_.wakeAll();
+    }
+
+    qsizetype SubtaskQueue::claim(const QSharedPointer<Batch>& batch) {
+        QMutexLocker locker(&mutex_);
+
+        if (batch->error && batch->next < batch->subtasks->count()) {
+            //a subtask has failed, the rest are not started at all
+            batch->pending -= batch->subtasks->count() - batch->next;
+            batch->next = batch->subtasks->count();
+            batches_.removeOne(batch);
+            if (batch->pending == 0)
+                batchCompleted_.wakeAll();
+        }
+
+        if (batch->next >= batch->subtasks->count())
+            return -1;
+
+        const qsizetype index = batch->next++;
+        if (batch->next == batch->subtasks->count())
+            batches_.removeOne(batch);
+
+        return index;
+    }
+
+    void SubtaskQueue::run(const QSharedPointer<Batch>& batch, qsizetype index) {
+        std::exception_ptr error;
+        try {
+            batch->subtasks->at(index)();
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        QMutexLocker locker(&mutex_);
+        if (error && !batch->error)
+            batch->error = error;
+        if (--batch->pending == 0)
+            batchCompleted_.wakeAll();
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <QList>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QWaitCondition>
+#include <exception>
+#include <functional>
+
+namespace pboman3::util {
+    //lets a long-running task split its work into fine-grained subtasks
+    //the threads which ran out of their own work take the subtasks over, so the tail of a batch runs on all the cores
+    class SubtaskQueue {
+    public:
+        typedef std::function<void()> Subtask;
+
+        //publishes the subtasks and executes them on the calling thread along with the helping threads
+        //returns when all the subtasks are done; rethrows the first exception any of them has thrown
+        void execute(const QList<Subtask>& subtasks);
+
+        //executes one of the subtasks published by another thread, returns false if there was none
+        bool help();
+
+        //blocks until new subtasks are published or the timeout elapses
+        void waitForWork(int msecs);
+
+        //blocks until new subtasks are published or the queue is closed
+        void waitForWork();
+
+        //wakes the threads waiting for work, the waits after it return at once
+        void close();
+
+    private:
+        struct Batch {
+            const QList<Subtask>* subtasks;
+            qsizetype next;
+            qsizetype pending;
+            std::exception_ptr error;
+        };
+
+        QMutex mutex_;
+        QWaitCondition workPublished_;
+        QWaitCondition batchCompleted_;
+        QList<QSharedPointer<Batch>> batches_;
+        bool closed_ = false;
+
+        qsizetype claim(const QSharedPointer<Batch>& batch);
+
+        void run(const QSharedPointer<Batch>& batch, qsizetype index);
+    };
+}
@@ -0,0 +1,114 @@
+#include "taskstats.h"
+#include <QMutexLocker>
+
+#ifdef Q_OS_WIN
+#include <Windows.h>
+#else
+#include <ctime>
+#endif
+
+namespace pboman3::util {
+    double PhaseStats::ratio() const {
+        return bytesIn > 0 ? static_cast<double>(bytesOut) / static_cast<double>(bytesIn) : 0;
+    }
+
+    QJsonObject PhaseStats::toJson() const {
+        QJsonObject json;
+        json.insert("name", name);
+        json.insert("wall_ms", static_cast<double>(wallNs) / 1000000);
+        json.insert("cpu_ms", static_cast<double>(cpuNs) / 1000000);
+        json.insert("bytes_in", bytesIn);
+        json.insert("bytes_out", bytesOut);
+        json.insert("ratio", ratio());
+        return json;
+    }
+
+    void TaskStats::addPhase(const PhaseStats& phase) {
+        QMutexLocker locker(&mutex_);
+        for (PhaseStats& existing : phases_) {
+            if (existing.name == phase.name) {
+                existing.wallNs += phase.wallNs;
+                existing.cpuNs += phase.cpuNs;
+                existing.bytesIn += phase.bytesIn;
+                existing.bytesOut += phase.bytesOut;
+                return;
+            }
+        }
+        phases_.append(phase);
+    }
+
+    void TaskStats::setBytes(qint64 bytesIn, qint64 bytesOut) {
+        QMutexLocker locker(&mutex_);
+        bytesIn_ = bytesIn;
+        bytesOut_ = bytesOut;
+    }
+
+    void TaskStats::setWallNs(qint64 wallNs) {
+        QMutexLocker locker(&mutex_);
+        wallNs_ = wallNs;
+    }
+
+    QList<PhaseStats> TaskStats::phases() const {
+        QMutexLocker locker(&mutex_);
+        return phases_;
+    }
+
+    PhaseStats TaskStats::total() const {
+        QMutexLocker locker(&mutex_);
+        PhaseStats total{"total", wallNs_, 0, bytesIn_, bytesOut_};
+        for (const PhaseStats& phase : phases_)
+            total.cpuNs += phase.cpuNs;
+        return total;
+    }
+
+    QJsonObject TaskStats::toJson() const {
+        QJsonArray phases;
+        for (const PhaseStats& phase : this->phases())
+            phases.append(phase.toJson());
+
+        QJsonObject json;
+        json.insert("phases", phases);
+        json.insert("total", total().toJson());
+        return json;
+    }
+
+    ScopedPhase::ScopedPhase(TaskStats* stats, QString name)
+        : stats_(stats),
+          phase_{std::move(name), 0, 0, 0, 0},
+          cpuStart_(0) {
+        if (stats_) {
+            cpuStart_ = ThreadCpuTimeNs();
+            wall_.start();
+        }
+    }
+
+    ScopedPhase::~ScopedPhase() {
+        if (stats_) {
+            phase_.wallNs = wall_.nsecsElapsed();
+            phase_.cpuNs = ThreadCpuTimeNs() - cpuStart_;
+            stats_->addPhase(phase_);
+        }
+    }
+
+    void ScopedPhase::addBytes(qint64 bytesIn, qint64 bytesOut) {
+        phase_.bytesIn += bytesIn;
+        phase_.bytesOut += bytesOut;
+    }
+
+    qint64 ThreadCpuTimeNs() {
+#ifdef Q_OS_WIN
+        FILETIME creation, exit, kernel, user;
+        if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user))
+            return 0;
+        const auto toNs = [](const FILETIME& time) {
+            return (static_cast<qint64>(time.dwHighDateTime) << 32 | time.dwLowDateTime) * 100;
+        };
+        return toNs(kernel) + toNs(user);
+#else
+        timespec time{};
+        if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0)
+            return 0;
+        return static_cast<qint64>(time.tv_sec) * 1000000000 + time.tv_nsec;
+#endif
+    }
+}
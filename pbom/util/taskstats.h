@@ -0,0 +1,66 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QList>
+#include <QMutex>
+#include <QString>
+
+namespace pboman3::util {
+    struct PhaseStats {
+        QString name;
+        qint64 wallNs;
+        qint64 cpuNs;
+        qint64 bytesIn;
+        qint64 bytesOut;
+
+        //out to in, i.e. below 1 if the phase compressed the data
+        double ratio() const;
+
+        QJsonObject toJson() const;
+    };
+
+    //the time and the bytes the phases of a task took, safe to update from several threads
+    class TaskStats {
+    public:
+        //the phases with the same name are summed up, e.g. the compression of the individual entries
+        void addPhase(const PhaseStats& phase);
+
+        void setBytes(qint64 bytesIn, qint64 bytesOut);
+
+        void setWallNs(qint64 wallNs);
+
+        QList<PhaseStats> phases() const;
+
+        //the wall time of the whole task and the CPU time of all its phases, wherever they ran
+        PhaseStats total() const;
+
+        QJsonObject toJson() const;
+
+    private:
+        mutable QMutex mutex_;
+        QList<PhaseStats> phases_;
+        qint64 wallNs_ = 0;
+        qint64 bytesIn_ = 0;
+        qint64 bytesOut_ = 0;
+    };
+
+    //measures the wall time and the CPU time of the current thread while in scope, does nothing if the stats are null
+    class ScopedPhase {
+    public:
+        ScopedPhase(TaskStats* stats, QString name);
+
+        ~ScopedPhase();
+
+        void addBytes(qint64 bytesIn, qint64 bytesOut);
+
+    private:
+        TaskStats* stats_;
+        PhaseStats phase_;
+        QElapsedTimer wall_;
+        qint64 cpuStart_;
+    };
+
+    qint64 ThreadCpuTimeNs();
+}
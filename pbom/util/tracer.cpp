@@ -0,0 +1,115 @@
+#include "tracer.h"
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QThread>
+#include "util/log.h"
+
+#define LOG(...) LOGGER("util/Tracer", __VA_ARGS__)
+
+namespace pboman3::util {
+    QAtomicInt Tracer::enabled_;
+    QMutex Tracer::buffersMutex_;
+    QList<Tracer::ThreadBuffer*> Tracer::buffers_;
+    QElapsedTimer Tracer::clock_;
+
+    void Tracer::start() {
+        QMutexLocker locker(&buffersMutex_);
+        if (!clock_.isValid())
+            clock_.start();
+        enabled_.storeRelease(1);
+        LOG(info, "Tracing started")
+    }
+
+    bool Tracer::stopAndWrite(const QString& path) {
+        enabled_.storeRelease(0);
+
+        QJsonArray events;
+        QMutexLocker locker(&buffersMutex_);
+        for (ThreadBuffer* buffer : buffers_) {
+            QJsonObject threadName;
+            threadName.insert("name", "thread_name");
+            threadName.insert("ph", "M");
+            threadName.insert("pid", 1);
+            threadName.insert("tid", buffer->threadId);
+            threadName.insert("args", QJsonObject{{"name", buffer->threadName}});
+            events.append(threadName);
+
+            QMutexLocker bufferLocker(&buffer->mutex);
+            for (const Event& event : buffer->events) {
+                QJsonObject item;
+                item.insert("name", event.name);
+                item.insert("cat", event.category);
+                item.insert("ph", "X");
+                item.insert("ts", event.startUs);
+                item.insert("dur", event.durationUs);
+                item.insert("pid", 1);
+                item.insert("tid", buffer->threadId);
+                if (!event.detail.isEmpty())
+                    item.insert("args", QJsonObject{{"detail", event.detail}});
+                events.append(item);
+            }
+            buffer->events.clear();
+        }
+
+        LOG(info, "Writing", events.count(), "trace events to:", path)
+
+        QFile file(path);
+        if (!file.open(QIODeviceBase::WriteOnly | QIODeviceBase::Truncate)) {
+            LOG(warning, "Could not open the trace file:", path)
+            return false;
+        }
+        file.write(QJsonDocument(QJsonObject{{"traceEvents", events}}).toJson(QJsonDocument::Compact));
+        return true;
+    }
+
+    qint64 Tracer::nowUs() {
+        return clock_.nsecsElapsed() / 1000;
+    }
+
+    void Tracer::record(Event event) {
+        ThreadBuffer* buffer = threadBuffer();
+        QMutexLocker locker(&buffer->mutex);
+        buffer->events.append(std::move(event));
+    }
+
+    Tracer::ThreadBuffer* Tracer::threadBuffer() {
+        //each thread appends to its own buffer, so the threads do not contend while tracing
+        //the buffers live till the process exit as the pool threads might outlive any owner
+        thread_local ThreadBuffer* buffer = nullptr;
+        if (!buffer) {
+            QMutexLocker locker(&buffersMutex_);
+            buffer = new ThreadBuffer;
+            buffer->threadId = static_cast<qint32>(buffers_.count()) + 1;
+            const QString name = QThread::currentThread()->objectName();
+            buffer->threadName = name.isEmpty() ? QString("Thread %1").arg(buffer->threadId) : name;
+            buffers_.append(buffer);
+        }
+        return buffer;
+    }
+
+    TraceScope::TraceScope(const char* category, const char* name)
+        : event_{category, name, QString(), 0, 0},
+          active_(Tracer::isEnabled()) {
+        if (active_)
+            event_.startUs = Tracer::nowUs();
+    }
+
+    TraceScope::TraceScope(const char* category, const char* name, const QString& detail)
+        : event_{category, name, QString(), 0, 0},
+          active_(Tracer::isEnabled()) {
+        if (active_) {
+            event_.detail = detail;
+            event_.startUs = Tracer::nowUs();
+        }
+    }
+
+    TraceScope::~TraceScope() {
+        if (active_) {
+            event_.durationUs = Tracer::nowUs() - event_.startUs;
+            Tracer::record(std::move(event_));
+        }
+    }
+}
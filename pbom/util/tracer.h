@@ -0,0 +1,72 @@
+#pragma once
+
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QList>
+#include <QMutex>
+#include <QString>
+
+#define M_TRACE_NAME2(LINE) trace_##LINE
+#define M_TRACE_NAME(LINE) M_TRACE_NAME2(LINE)
+
+//TRACE_SCOPE(category, name) or TRACE_SCOPE(category, name, detail), records the enclosing scope when tracing is on
+#define TRACE_SCOPE(...) const pboman3::util::TraceScope M_TRACE_NAME(__LINE__)(__VA_ARGS__);
+
+namespace pboman3::util {
+    //collects the scoped events of all the threads and writes them in the Chrome trace format,
+    //which chrome://tracing and Perfetto can open
+    class Tracer {
+    public:
+        struct Event {
+            const char* category;
+            const char* name;
+            QString detail;
+            qint64 startUs;
+            qint64 durationUs;
+        };
+
+        static void start();
+
+        static bool isEnabled() {
+            return enabled_.loadRelaxed() != 0;
+        }
+
+        //stops the tracing and writes the events collected so far, returns false if the file could not be written
+        static bool stopAndWrite(const QString& path);
+
+        static qint64 nowUs();
+
+        static void record(Event event);
+
+    private:
+        struct ThreadBuffer {
+            qint32 threadId;
+            QString threadName;
+            QMutex mutex;
+            QList<Event> events;
+        };
+
+        static QAtomicInt enabled_;
+
+        static QMutex buffersMutex_;
+
+        static QList<ThreadBuffer*> buffers_;
+
+        static QElapsedTimer clock_;
+
+        static ThreadBuffer* threadBuffer();
+    };
+
+    class TraceScope {
+    public:
+        TraceScope(const char* category, const char* name);
+
+        TraceScope(const char* category, const char* name, const QString& detail);
+
+        ~TraceScope();
+
+    private:
+        Tracer::Event event_;
+        bool active_;
+    };
+}